@@ -2,8 +2,8 @@
 
 static lv_obj_t *main_cont;
 
-static void about_enter(void) {
-  main_cont = lv_obj_create(lv_scr_act());
+static void about_enter(lv_obj_t *scr) {
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_scrollbar_mode(main_cont, LV_SCROLLBAR_MODE_OFF);
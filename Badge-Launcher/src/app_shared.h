@@ -6,22 +6,72 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+/* Buttons
+ * Debounced by the launcher from GPIO interrupts (debounce.c), or by the
+ * gpio-keys input driver when CONFIG_BADGE_BUTTON_DEBOUNCE is off, then
+ * queued with their edge times (buttons.c). Apps get every edge through
+ * App.input, so presses shorter than a frame are not lost.
+ */
+typedef enum {
+  BTN_UP,
+  BTN_DOWN,
+  BTN_LEFT,
+  BTN_RIGHT,
+  BTN_SELECT,
+  BTN_BACK,
+  BTN_COUNT
+} Button;
+
+typedef enum {
+  BTN_PRESSED,
+  BTN_RELEASED,
+  BTN_REPEAT,     // Held past repeat_delay_ms, gaps shrink while held
+  BTN_LONG_PRESS, // Held alone for long_press_ms, once per press
+  BTN_CHORD,      // Follows the PRESSED that made two or more chord buttons
+} ButtonAction;
+
+typedef struct {
+  int64_t uptime_ms;    // When the edge was reported (repeats: when due)
+  uint64_t edge_cycles; // k_cycle_get_64() estimate of the GPIO edge
+  uint8_t button;       // Button
+  uint8_t action;       // ButtonAction
+  uint8_t held;         // BIT(Button) of every button down after this event
+  uint8_t steps;        // BTN_REPEAT: repeats due at once (>1 after a stall)
+} ButtonEvent;
+
+/* Per-app gesture timings, App.buttons = NULL uses the launcher defaults */
+typedef struct {
+  uint16_t repeat_delay_ms;    // Hold before the first repeat, 0 = no repeat
+  uint16_t repeat_interval_ms; // Gap before the second repeat
+  uint16_t repeat_min_ms;      // Gap floor once accelerated
+  uint8_t repeat_accel_pct;    // Each gap is this much shorter than the last
+  uint16_t long_press_ms;      // 0 = no BTN_LONG_PRESS
+  uint8_t chord_mask;          // BIT(Button) set that forms chords, 0 = none
+} ButtonTiming;
+
+/* How an app's screen changes reach the e-ink panel (see refresh.h) */
+typedef enum {
+  REFRESH_BALANCED, // Partial, a full refresh when ghosting builds up or idle
+  REFRESH_FAST,     // Games: partial for as long as the panel stands it
+  REFRESH_QUALITY,  // Static pages: every change is a full refresh
+} RefreshPolicy;
+
 /* App Interface */
 typedef struct {
   const char *name;
-  void (*enter)(void);
-  void (*update)(void);
-  void (*exit)(void);
+  void (*enter)(lv_obj_t *scr);          // Build UI on scr (not yet loaded)
+  void (*update)(void);                  // Every loop wakeup
+  void (*input)(const ButtonEvent *evt); // Button events (BACK: menu only)
+  void (*exit)(void);                    // Tear down (retained: on eviction)
+  void (*suspend)(void);                 // Optional, leaving, screen retained
+  void (*resume)(void);                  // Set to retain the screen
+  uint32_t tick_ms;                      // Fixed timestep, 0 = not ticked
+  void (*tick)(void);                    // Game logic, every tick_ms
+  const ButtonTiming *buttons;           // Repeat/long-press/chord timings
+  uint8_t refresh;                       // RefreshPolicy
 } App;
 
 /* Hardware Definitions (Available to all apps) */
-extern const struct gpio_dt_spec btn_up;
-extern const struct gpio_dt_spec btn_down;
-extern const struct gpio_dt_spec btn_left;
-extern const struct gpio_dt_spec btn_right;
-extern const struct gpio_dt_spec btn_select;
-extern const struct gpio_dt_spec btn_back;
-
 extern const struct gpio_dt_spec led_red;
 extern const struct gpio_dt_spec led_green;
 extern const struct gpio_dt_spec led_blue;
@@ -35,4 +85,24 @@ void play_beep_die(void);
 
 void return_to_menu(void);
 
+bool button_held(Button btn);        // Current level, safe from any thread
+const char *button_name(Button btn); // Lower-case ("up", "select", ...)
+
+/*
+ * Time and randomness for app logic. Input replay swaps in a virtual clock
+ * and a recorded seed, so apps use these instead of k_uptime_get() and
+ * sys_rand32_get() to replay deterministically.
+ */
+int64_t app_uptime_get(void);
+uint32_t app_rand32(void);
+
+/*
+ * Scheduling: the launcher sleeps until a button edge, an LVGL timer or a
+ * requested deadline (app_uptime_get() time). Apps that animate must
+ * re-request from every update().
+ */
+void request_update_at(int64_t uptime_ms);
+void request_update_in(uint32_t delay_ms);
+void wake_launcher(void); // ISR-safe
+
 #endif
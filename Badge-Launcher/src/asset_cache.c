@@ -0,0 +1,261 @@
+#include "asset_cache.h"
+
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+#define METHOD_RLE 1 // LV_IMAGE_COMPRESS_RLE
+#define HEADER_SIZE 12
+
+typedef struct {
+  const lv_image_dsc_t *img;
+  uint8_t *data;
+  uint32_t size;
+  uint32_t last_use; // Acquire order, lowest is evicted first
+  uint32_t uses;
+  uint16_t pinned; // Acquired and not released yet
+} CachedAsset;
+
+static CachedAsset cache[CONFIG_BADGE_ASSET_CACHE_SLOTS];
+static uint32_t use_counter;
+
+/* Stats (launcher thread writes) */
+static uint32_t hits;
+static uint32_t misses;
+static uint32_t evictions;
+static uint32_t pressure_evictions; // Made room for a failed allocation
+static uint32_t failures;
+static uint64_t unpack_cycles;
+static uint32_t max_unpack_cycles;
+static uint32_t unpacked_bytes;
+
+/* Requested from the shell thread, applied on the next acquire */
+static atomic_t flush_pending;
+
+static bool read_header(const lv_image_dsc_t *img, uint32_t *packed,
+                        uint32_t *unpacked) {
+  uint32_t header[3]; // method, compressed size, unpacked size
+
+  if (!(img->header.flags & LV_IMAGE_FLAGS_COMPRESSED) ||
+      img->data_size < HEADER_SIZE)
+    return false;
+  memcpy(header, img->data, HEADER_SIZE);
+  if ((header[0] & 0xf) != METHOD_RLE ||
+      header[1] > img->data_size - HEADER_SIZE)
+    return false;
+  *packed = header[1];
+  *unpacked = header[2];
+  return true;
+}
+
+// Returns false unless src fills exactly size bytes of dst
+static bool unpack_rle(const uint8_t *src, uint32_t src_size, uint8_t *dst,
+                       uint32_t size) {
+  const uint8_t *end = src + src_size;
+  uint32_t out = 0;
+
+  while (src < end) {
+    uint8_t ctrl = *src++;
+    uint32_t count = ctrl & 0x7f;
+
+    if (count > size - out)
+      return false;
+    if (ctrl & 0x80) {
+      if (count > (uint32_t)(end - src))
+        return false;
+      memcpy(dst + out, src, count);
+      src += count;
+    } else {
+      if (src == end)
+        return false;
+      memset(dst + out, *src++, count);
+    }
+    out += count;
+  }
+  return out == size;
+}
+
+static size_t cached_bytes(void) {
+  size_t total = 0;
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].img)
+      total += cache[i].size;
+  }
+  return total;
+}
+
+static void evict(CachedAsset *entry) {
+  lv_free(entry->data);
+  memset(entry, 0, sizeof(*entry));
+  evictions++;
+}
+
+// Least recently used of the entries not being drawn
+static CachedAsset *least_recently_used(void) {
+  CachedAsset *lru = NULL;
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].img && !cache[i].pinned &&
+        (!lru || cache[i].last_use < lru->last_use))
+      lru = &cache[i];
+  }
+  return lru;
+}
+
+static void trim(void) {
+  CachedAsset *lru;
+
+  while (cached_bytes() > CONFIG_BADGE_ASSET_CACHE_BUDGET &&
+         (lru = least_recently_used()))
+    evict(lru);
+}
+
+static void apply_pending_flush(void) {
+  if (!atomic_cas(&flush_pending, 1, 0))
+    return;
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].img && !cache[i].pinned)
+      evict(&cache[i]);
+  }
+}
+
+uint32_t asset_cache_unpacked_size(const lv_image_dsc_t *img) {
+  uint32_t packed, unpacked;
+
+  return read_header(img, &packed, &unpacked) ? unpacked : 0;
+}
+
+const uint8_t *asset_cache_acquire(const lv_image_dsc_t *img) {
+  apply_pending_flush();
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].img == img) {
+      cache[i].last_use = ++use_counter;
+      cache[i].uses++;
+      cache[i].pinned++;
+      hits++;
+      return cache[i].data;
+    }
+  }
+
+  uint32_t packed, size;
+  if (!read_header(img, &packed, &size))
+    return NULL;
+
+  // A free slot, then the memory, dropping old sprites while either is short
+  CachedAsset *slot = NULL;
+  for (int i = 0; i < ARRAY_SIZE(cache) && !slot; i++) {
+    if (!cache[i].img)
+      slot = &cache[i];
+  }
+  if (!slot) {
+    slot = least_recently_used();
+    if (!slot) {
+      failures++;
+      return NULL;
+    }
+    evict(slot);
+  }
+
+  uint8_t *data;
+  CachedAsset *lru;
+  while (!(data = lv_malloc(size)) && (lru = least_recently_used())) {
+    evict(lru);
+    pressure_evictions++;
+  }
+  if (!data) {
+    LOG_WRN("No memory to unpack a %ux%u sprite (%u bytes)", img->header.w,
+            img->header.h, size);
+    failures++;
+    return NULL;
+  }
+
+  uint32_t start = k_cycle_get_32();
+  if (!unpack_rle(img->data + HEADER_SIZE, packed, data, size)) {
+    LOG_ERR("Corrupt compressed %ux%u sprite", img->header.w, img->header.h);
+    lv_free(data);
+    failures++;
+    return NULL;
+  }
+  uint32_t cycles = k_cycle_get_32() - start;
+  unpack_cycles += cycles;
+  max_unpack_cycles = MAX(max_unpack_cycles, cycles);
+  unpacked_bytes += size;
+  misses++;
+
+  slot->img = img;
+  slot->data = data;
+  slot->size = size;
+  slot->last_use = ++use_counter;
+  slot->uses = 1;
+  slot->pinned = 1;
+  return data;
+}
+
+void asset_cache_release(const lv_image_dsc_t *img) {
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].img == img && cache[i].pinned) {
+      cache[i].pinned--;
+      break;
+    }
+  }
+  // Over budget (one sprite bigger than all of it): drop until it fits
+  trim();
+}
+
+/* Shell: badge assets [flush|reset] */
+static int cmd_assets(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "flush") == 0) {
+      atomic_set(&flush_pending, 1);
+      shell_print(sh, "Unpacked sprites dropped on the next draw");
+      return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0) {
+      hits = misses = evictions = pressure_evictions = failures = 0;
+      max_unpack_cycles = unpacked_bytes = 0;
+      unpack_cycles = 0;
+      return 0;
+    }
+    shell_error(sh, "Usage: badge assets [flush|reset]");
+    return -EINVAL;
+  }
+
+  uint32_t lookups = hits + misses;
+  shell_print(sh, "Unpacked: %u / %u bytes", (unsigned)cached_bytes(),
+              CONFIG_BADGE_ASSET_CACHE_BUDGET);
+  shell_print(sh, "Hits: %u, misses: %u (%u%% hit rate), failures: %u", hits,
+              misses, lookups ? hits * 100 / lookups : 0, failures);
+  shell_print(sh, "Evictions: %u, %u of them for lack of memory", evictions,
+              pressure_evictions);
+  if (misses)
+    shell_print(sh, "Unpack: %u bytes, avg %u us, max %u us", unpacked_bytes,
+                (uint32_t)k_cyc_to_us_ceil64(unpack_cycles / misses),
+                k_cyc_to_us_ceil32(max_unpack_cycles));
+
+  // Most recently used first
+  uint32_t below = UINT32_MAX;
+  for (int n = 0; n < ARRAY_SIZE(cache); n++) {
+    const CachedAsset *next = NULL;
+    for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+      if (cache[i].img && cache[i].last_use < below &&
+          (!next || cache[i].last_use > next->last_use))
+        next = &cache[i];
+    }
+    if (!next)
+      break;
+    shell_print(sh, "  %3ux%-3u %6u bytes from %5u, %u draws",
+                next->img->header.w, next->img->header.h, next->size,
+                next->img->data_size, next->uses);
+    below = next->last_use;
+  }
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), assets, NULL,
+                 "Unpacked compressed sprites (LRU)\n"
+                 "Usage: badge assets [flush|reset]",
+                 cmd_assets, 1, 1);
@@ -0,0 +1,32 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include "app_shared.h"
+
+/*
+ * Compressed sprite assets. convert_sprites.py run-length codes an I1 image
+ * (palette and packed rows) when that saves enough, and flags it
+ * LV_IMAGE_FLAGS_COMPRESSED. The data then starts with LVGL's 12-byte
+ * compressed header (method, compressed and unpacked size) followed by
+ * LVGL's RLE stream with 1-byte blocks: a control byte with bit 7 set copies
+ * that many literal bytes, otherwise repeats the next byte that many times.
+ *
+ * image_1bpp.c unpacks an image on its first draw into the LVGL heap and
+ * keeps it, least recently drawn evicted first, within
+ * CONFIG_BADGE_ASSET_CACHE_BUDGET and CONFIG_BADGE_ASSET_CACHE_SLOTS, or
+ * sooner when an allocation fails. Hit rate and unpack times are on
+ * "badge assets".
+ */
+
+/* Unpacked size of a compressed image, 0 if img is not one or is corrupt */
+uint32_t asset_cache_unpacked_size(const lv_image_dsc_t *img);
+
+/*
+ * The unpacked data of img (palette first), unpacking it on a miss. NULL if
+ * it cannot be unpacked. Stays valid until asset_cache_release().
+ */
+const uint8_t *asset_cache_acquire(const lv_image_dsc_t *img);
+
+void asset_cache_release(const lv_image_dsc_t *img);
+
+#endif
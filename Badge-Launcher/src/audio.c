@@ -0,0 +1,555 @@
+#include "audio.h"
+#include "mixer.h"
+#include "music.h"
+#include "tone.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+/* The old inline beeps: a fixed blip and two sweeps */
+static const SfxDef sfx_defs[SFX_COUNT] = {
+    [SFX_MOVE] = {.name = "move",
+                  .start_hz = 2000,
+                  .end_hz = 2000,
+                  .duration_ms = 10,
+                  .priority = 0,
+                  .category = AUDIO_UI},
+    [SFX_EAT] = {.name = "eat",
+                 .start_hz = 1000,
+                 .end_hz = 1960,
+                 .duration_ms = 38,
+                 .curve = SFX_LINEAR_PERIOD,
+                 .priority = 1},
+    [SFX_DIE] = {.name = "die",
+                 .start_hz = 500,
+                 .end_hz = 168,
+                 .duration_ms = 398,
+                 .curve = SFX_LINEAR_PERIOD,
+                 .decay_ms = 100,
+                 .priority = 2},
+};
+
+/* Bench only: a falling sweep on the default curve, like Froggr's splash */
+static const SfxDef sfx_fall = {.name = "fall",
+                                .start_hz = 1200,
+                                .end_hz = 200,
+                                .duration_ms = 300,
+                                .priority = 2};
+
+static const SfxDef *const bench_defs[] = {
+    &sfx_defs[SFX_MOVE], &sfx_defs[SFX_EAT], &sfx_defs[SFX_DIE], &sfx_fall};
+
+/* Period multipliers for 1-11 semitones up, 0.16 fixed point */
+static const uint16_t semitone_up[12] = {
+    0,     61858, 58386, 55109, 52016, 49097,
+    46341, 43740, 41285, 38968, 36781, 34716,
+};
+
+/* Command ring: producer is the launcher thread, consumer the audio thread */
+#define RING_SIZE 16 // Power of two
+#define CMD_STOP NULL
+#define CMD_TONE (&tone_cmd) // Plays test_tone with tone_params
+
+static const SfxDef tone_cmd;
+
+static const SfxDef *ring[RING_SIZE];
+static atomic_t ring_head; // Next slot to write, producer only
+static atomic_t ring_tail; // Next slot to read, audio thread only
+
+K_SEM_DEFINE(audio_kick, 0, 1);
+
+static atomic_t muted;
+static atomic_t shell_sfx;   // Bench effect for audio_poll(), bench_defs + 1
+static atomic_t shell_tone;  // Test tone for audio_poll(), hz << 16 | ms
+static atomic_t tone_params; // The one CMD_TONE plays, same encoding
+static atomic_t levels[AUDIO_CATEGORIES] = {
+    [AUDIO_SFX] = ATOMIC_INIT(AUDIO_LEVEL_MAX),
+    [AUDIO_UI] = ATOMIC_INIT(AUDIO_LEVEL_MAX),
+    [AUDIO_MUSIC] = ATOMIC_INIT(AUDIO_LEVEL_MAX),
+};
+
+static const char *const category_names[AUDIO_CATEGORIES] = {
+    [AUDIO_SFX] = "sfx",
+    [AUDIO_UI] = "ui",
+    [AUDIO_MUSIC] = "music",
+};
+
+#define DUCK_PERCENT 40  // Music volume under a game effect
+#define DUCK_HOLD_MS 150 // Music stays down this long after one ends
+
+/* Stats (audio thread writes, shell reads) */
+static uint32_t played;
+static uint32_t preempted;
+static uint32_t waited;
+static atomic_t dropped; // Ring or wait list full
+static uint32_t max_enqueue_cycles;
+
+/* Lower-priority effects waiting for the one playing, oldest first */
+#define WAIT_SLOTS 4
+
+static const SfxDef *wait_list[WAIT_SLOTS];
+static int num_waiting;
+
+static void push_cmd(const SfxDef *cmd) {
+  uint32_t start = k_cycle_get_32();
+  atomic_val_t head = atomic_get(&ring_head);
+
+  if (head - atomic_get(&ring_tail) >= RING_SIZE) {
+    atomic_inc(&dropped);
+    return;
+  }
+  ring[head & (RING_SIZE - 1)] = cmd;
+  atomic_set(&ring_head, head + 1); // Publishes the slot
+  k_sem_give(&audio_kick);
+
+  max_enqueue_cycles = MAX(max_enqueue_cycles, k_cycle_get_32() - start);
+}
+
+void audio_play_sfx(const SfxDef *sfx) {
+  if (sfx && sfx->duration_ms && !atomic_get(&muted) &&
+      atomic_get(&levels[sfx->category]) && tone_ready())
+    push_cmd(sfx);
+}
+
+void audio_play(Sfx sfx) {
+  if (sfx < SFX_COUNT)
+    audio_play_sfx(&sfx_defs[sfx]);
+}
+
+void audio_stop(void) { push_cmd(CMD_STOP); }
+
+void audio_poll(void) {
+  atomic_val_t bench = atomic_set(&shell_sfx, 0);
+  atomic_val_t tone = atomic_set(&shell_tone, 0);
+
+  if (bench)
+    audio_play_sfx(bench_defs[bench - 1]);
+  if (tone && !atomic_get(&muted) && atomic_get(&levels[AUDIO_SFX]) &&
+      tone_ready()) {
+    atomic_set(&tone_params, tone);
+    push_cmd(CMD_TONE);
+  }
+}
+
+// Hands a shell request to the launcher and waits for it to be queued
+static bool request_from_shell(atomic_t *request, atomic_val_t value) {
+  atomic_set(request, value);
+  wake_launcher();
+  for (int ms = 0; atomic_get(request) && ms < 1000; ms += 10)
+    k_msleep(10);
+  return !atomic_cas(request, value, 0);
+}
+
+bool audio_request_tone(uint16_t hz, uint16_t ms) {
+  return ms && request_from_shell(&shell_tone, (uint32_t)hz << 16 | ms);
+}
+
+void audio_wake(void) { k_sem_give(&audio_kick); }
+
+void audio_set_muted(bool mute) {
+  atomic_set(&muted, mute);
+  if (mute)
+    audio_stop();
+  else
+    audio_wake(); // Bring the music back in
+}
+
+bool audio_muted(void) { return atomic_get(&muted); }
+
+void audio_set_level(AudioCategory category, uint8_t level) {
+  if (category >= AUDIO_CATEGORIES)
+    return;
+  atomic_set(&levels[category], MIN(level, AUDIO_LEVEL_MAX));
+  audio_wake(); // Music picks the new level up at once
+}
+
+uint8_t audio_level(AudioCategory category) {
+  return category < AUDIO_CATEGORIES ? atomic_get(&levels[category]) : 0;
+}
+
+// Percent of full volume for a category
+static uint8_t gain(AudioCategory category) {
+  return atomic_get(&levels[category]) * 100 / AUDIO_LEVEL_MAX;
+}
+
+/* Settings: "audio/muted" and "audio/levels", a byte per category */
+#ifdef CONFIG_SETTINGS
+static int audio_settings_set(const char *name, size_t len,
+                              settings_read_cb read_cb, void *cb_arg) {
+  uint8_t saved[AUDIO_CATEGORIES];
+  int rc;
+
+  if (settings_name_steq(name, "muted", NULL)) {
+    rc = read_cb(cb_arg, saved, 1);
+    if (rc < 1)
+      return rc < 0 ? rc : -EINVAL;
+    atomic_set(&muted, saved[0] != 0);
+    return 0;
+  }
+  if (settings_name_steq(name, "levels", NULL)) {
+    // Categories missing from an older save keep their defaults
+    rc = read_cb(cb_arg, saved, MIN(len, sizeof(saved)));
+    if (rc < 0)
+      return rc;
+    for (int i = 0; i < rc; i++)
+      atomic_set(&levels[i], MIN(saved[i], AUDIO_LEVEL_MAX));
+    return 0;
+  }
+  return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(audio, "audio", NULL, audio_settings_set, NULL,
+                               NULL);
+#endif
+
+void audio_save_settings(void) {
+#ifdef CONFIG_SETTINGS
+  uint8_t saved[AUDIO_CATEGORIES];
+  uint8_t mute = atomic_get(&muted);
+
+  for (int i = 0; i < AUDIO_CATEGORIES; i++)
+    saved[i] = atomic_get(&levels[i]);
+
+  int rc = settings_save_one("audio/levels", saved, sizeof(saved));
+  if (rc == 0)
+    rc = settings_save_one("audio/muted", &mute, sizeof(mute));
+  if (rc < 0)
+    LOG_WRN("Sound settings not saved (%d)", rc);
+#endif
+}
+
+void play_beep_move(void) { audio_play(SFX_MOVE); }
+void play_beep_eat(void) { audio_play(SFX_EAT); }
+void play_beep_die(void) { audio_play(SFX_DIE); }
+
+/* Audio thread */
+static const SfxDef *playing;
+static int64_t sfx_start;      // Uptime the effect started
+static uint32_t sweep_from_ns; // Periods at the ends of the sweep
+static uint32_t sweep_to_ns;
+static bool on_mixer;       // Effects play on MIXER_SFX
+static int64_t duck_until; // Uptime music comes back to its level
+
+static void start(const SfxDef *sfx) {
+  playing = sfx;
+  sfx_start = k_uptime_get();
+  sweep_from_ns = NSEC_PER_SEC / MAX(sfx->start_hz, 1);
+  sweep_to_ns = NSEC_PER_SEC / MAX(sfx->end_hz, 1);
+  played++;
+#ifdef CONFIG_BADGE_MIXER
+  on_mixer = mixer_ready();
+  if (on_mixer) {
+    mixer_set_duty(MIXER_SFX, sfx->duty ? sfx->duty : 50);
+    mixer_start();
+  }
+#endif
+}
+
+static void finish(void) {
+#ifdef CONFIG_BADGE_MIXER
+  if (on_mixer)
+    mixer_set(MIXER_SFX, 0, 0);
+#endif
+  playing = NULL;
+}
+
+// Period at t ms in, from_ns and to_ns being the periods at the two ends
+static uint32_t sfx_period_ns(const SfxDef *sfx, uint32_t from_ns,
+                              uint32_t to_ns, uint32_t t) {
+  uint32_t ms = sfx->duration_ms;
+  uint32_t period;
+
+  if (sfx->curve == SFX_LINEAR_PERIOD) {
+    period = from_ns + ((int64_t)to_ns - from_ns) * (int32_t)t / (int32_t)ms;
+  } else {
+    int32_t hz = sfx->start_hz + ((int32_t)sfx->end_hz - sfx->start_hz) *
+                                     (int32_t)t / (int32_t)ms;
+    period = NSEC_PER_SEC / MAX(hz, 1);
+  }
+
+  if (sfx->arp_ms && sfx->arp_steps) {
+    int semis = sfx->arp[(t / sfx->arp_ms) % MIN(sfx->arp_steps, SFX_ARP_MAX)];
+    int octaves = semis >= 0 ? semis / 12 : (semis - 11) / 12;
+    int rest = semis - 12 * octaves;
+
+    if (rest)
+      period = (uint64_t)period * semitone_up[rest] >> 16;
+    period = octaves >= 0 ? period >> octaves : period << -octaves;
+  }
+  return period;
+}
+
+static uint8_t sfx_volume(const SfxDef *sfx, uint32_t t) {
+  uint32_t peak = sfx->volume ? sfx->volume : 15;
+  uint32_t left = sfx->duration_ms - t;
+
+  if (t < sfx->attack_ms)
+    return peak * t / sfx->attack_ms;
+  if (left < sfx->decay_ms)
+    return peak * left / sfx->decay_ms;
+  return peak;
+}
+
+// One SFX_STEP_MS step of the playing effect
+static void render_step(void) {
+  uint32_t t = k_uptime_get() - sfx_start;
+
+  if (t >= playing->duration_ms) {
+    finish();
+    return;
+  }
+
+  uint32_t period = sfx_period_ns(playing, sweep_from_ns, sweep_to_ns, t);
+  uint8_t percent = gain(playing->category);
+#ifdef CONFIG_BADGE_MIXER
+  if (on_mixer) {
+    // The mixer's phase accumulator carries on across retunes, no clicks
+    mixer_set(MIXER_SFX, period,
+              DIV_ROUND_UP(sfx_volume(playing, t) * percent, 100));
+    k_sem_take(&audio_kick, K_MSEC(SFX_STEP_MS));
+    return;
+  }
+#endif
+  tone_set_gain(percent);
+#ifdef CONFIG_BADGE_TONE_BUSY
+  // One period a step: a whole-millisecond window would cut every period
+  // short at 1 kHz. tone_play_ns() rounds down to a single period.
+  tone_play_ns(period, period / NSEC_PER_USEC);
+#else
+  tone_play_ns(period, SFX_STEP_MS * 1000); // Retuned from the next edge
+#endif
+}
+
+static void handle_cmd(const SfxDef *cmd) {
+  // Only this thread touches test_tone, and at top priority it never waits:
+  // rewriting it cuts the last test tone off like any other preemption
+  static SfxDef test_tone = {.name = "tone", .priority = UINT8_MAX};
+
+  if (cmd == CMD_TONE) {
+    atomic_val_t params = atomic_get(&tone_params);
+
+    test_tone.start_hz = test_tone.end_hz = params >> 16;
+    test_tone.duration_ms = params & 0xffff;
+    cmd = &test_tone;
+  }
+  if (cmd == CMD_STOP) {
+    if (playing)
+      finish();
+    num_waiting = 0;
+    return;
+  }
+
+  if (!playing || cmd->priority >= playing->priority) {
+    if (playing)
+      preempted++;
+    start(cmd);
+  } else if (num_waiting < WAIT_SLOTS) {
+    wait_list[num_waiting++] = cmd;
+    waited++;
+  } else {
+    atomic_inc(&dropped);
+  }
+}
+
+static void drain_ring(void) {
+  atomic_val_t tail = atomic_get(&ring_tail);
+
+  while (tail != atomic_get(&ring_head)) {
+    handle_cmd(ring[tail & (RING_SIZE - 1)]);
+    atomic_set(&ring_tail, ++tail); // Frees the slot
+  }
+}
+
+// Music has the buzzer between effects, and under them on the mixer
+static uint8_t music_gain(int64_t now) {
+  if (atomic_get(&muted) || (playing && !on_mixer))
+    return 0;
+  if (playing && playing->category == AUDIO_SFX)
+    duck_until = now + DUCK_HOLD_MS;
+  if (now < duck_until)
+    return gain(AUDIO_MUSIC) * DUCK_PERCENT / 100;
+  return gain(AUDIO_MUSIC);
+}
+
+static void audio_thread(void *p1, void *p2, void *p3) {
+  for (;;) {
+    drain_ring();
+
+    if (atomic_get(&muted)) {
+      if (playing)
+        finish();
+      num_waiting = 0;
+    }
+
+    if (!playing && num_waiting) {
+      start(wait_list[0]);
+      memmove(wait_list, wait_list + 1, --num_waiting * sizeof(wait_list[0]));
+    }
+
+    int64_t now = k_uptime_get();
+    int32_t wait_ms = music_service(music_gain(now));
+
+    if (playing) {
+      render_step();
+      continue;
+    }
+    if (now < duck_until && wait_ms != SYS_FOREVER_MS)
+      wait_ms = MIN(wait_ms, duck_until - now); // Bring the music back up
+
+    if (wait_ms == SYS_FOREVER_MS) {
+      tone_stop();
+#ifdef CONFIG_BADGE_MIXER
+      mixer_stop(); // Nothing left on it
+#endif
+      k_sem_take(&audio_kick, K_FOREVER);
+    } else if (wait_ms > 0) {
+      k_sem_take(&audio_kick, K_MSEC(wait_ms));
+    }
+  }
+}
+
+K_THREAD_DEFINE(audio_tid, CONFIG_BADGE_AUDIO_STACK_SIZE, audio_thread, NULL,
+                NULL, NULL, CONFIG_BADGE_AUDIO_PRIORITY, 0, 0);
+
+/* Shell: badge audio bench [move|eat|die|fall] */
+#define BENCH_SEGMENTS 8
+
+static void bench_report(const struct shell *sh, const SfxDef *sfx,
+                         const uint32_t *edges, uint16_t count) {
+  uint32_t from_ns = NSEC_PER_SEC / MAX(sfx->start_hz, 1);
+  uint32_t to_ns = NSEC_PER_SEC / MAX(sfx->end_hz, 1);
+  uint32_t expected[BENCH_SEGMENTS] = {0}; // Thousandths of a period
+  uint32_t got[BENCH_SEGMENTS] = {0};
+  int short_segments = 0;
+
+  // Periods the sweep should fit in each segment, a step at a time
+  for (uint32_t t = 0; t < sfx->duration_ms; t += SFX_STEP_MS) {
+    uint32_t period = sfx_period_ns(sfx, from_ns, to_ns, t);
+    expected[t * BENCH_SEGMENTS / sfx->duration_ms] +=
+        1000ULL * SFX_STEP_MS * NSEC_PER_MSEC / MAX(period, 1);
+  }
+  // Rising edges against the first, which starts the sweep
+  for (int i = 0; i < count; i++) {
+    uint32_t ms = k_cyc_to_us_near64(edges[i] - edges[0]) / 1000;
+    if (ms < sfx->duration_ms)
+      got[ms * BENCH_SEGMENTS / sfx->duration_ms]++;
+  }
+
+  for (int i = 0; i < BENCH_SEGMENTS; i++) {
+    bool is_short = got[i] * 2000 < expected[i];
+
+    shell_print(sh, "  %3u-%3u ms: %3u edges, expected %u.%03u%s",
+                i * sfx->duration_ms / BENCH_SEGMENTS,
+                (i + 1) * sfx->duration_ms / BENCH_SEGMENTS, got[i],
+                expected[i] / 1000, expected[i] % 1000,
+                is_short ? " SHORT" : "");
+    short_segments += is_short;
+  }
+  if (short_segments)
+    shell_print(sh, "%d of %d segments under half their edges",
+                short_segments, BENCH_SEGMENTS);
+  else
+    shell_print(sh, "Edges across the whole sweep");
+  if (count == TONE_PROBE_EDGES)
+    shell_print(sh, "(edge log full at %d, later edges not counted)",
+                TONE_PROBE_EDGES);
+}
+
+static int cmd_bench(const struct shell *sh, size_t argc, char **argv) {
+  int index = SFX_DIE;
+  MusicStatus st;
+
+  if (argc > 2) {
+    for (index = 0; index < ARRAY_SIZE(bench_defs); index++) {
+      if (strcmp(argv[2], bench_defs[index]->name) == 0)
+        break;
+    }
+    if (index == ARRAY_SIZE(bench_defs)) {
+      shell_error(sh, "Usage: badge audio bench [move|eat|die|fall]");
+      return -EINVAL;
+    }
+  }
+
+  const SfxDef *sfx = bench_defs[index];
+  if (atomic_get(&muted) || !atomic_get(&levels[sfx->category])) {
+    shell_error(sh, "Sound is muted or %s is at level 0",
+                category_names[sfx->category]);
+    return -EPERM;
+  }
+  music_get_status(&st);
+  if (st.state == MUSIC_PLAYING) {
+    shell_error(sh, "Music is playing, its edges would mix in");
+    return -EBUSY;
+  }
+
+  ToneProbeStats probe;
+  uint16_t count;
+
+  // Queued by the launcher, the ring's only producer
+  tone_probe_arm();
+  if (!request_from_shell(&shell_sfx, index + 1)) {
+    tone_probe_disarm(&probe);
+    shell_error(sh, "The launcher did not pick the effect up");
+    return -ETIMEDOUT;
+  }
+  k_msleep(sfx->duration_ms + 50);
+  tone_probe_disarm(&probe);
+  const uint32_t *edges = tone_probe_edges(&count);
+
+  shell_print(sh, "%s: %u ms, %u to %u Hz on %s, %u rising edges", sfx->name,
+              sfx->duration_ms, sfx->start_hz, sfx->end_hz,
+              on_mixer ? "mixer" : tone_backend_name, count);
+  if (count) {
+    bench_report(sh, sfx, edges, count);
+  } else if (on_mixer || IS_ENABLED(CONFIG_BADGE_TONE_PWM)) {
+    shell_print(sh, "The %s has no edges to probe",
+                on_mixer ? "mixer" : "PWM backend");
+  } else {
+    shell_error(sh, "No edges: the effect was silent");
+    return -EIO;
+  }
+  return 0;
+}
+
+/* Shell: badge audio [<category> <level>|bench [effect]] */
+static int cmd_audio(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "bench") == 0)
+      return cmd_bench(sh, argc, argv);
+    for (int i = 0; i < AUDIO_CATEGORIES && argc == 3; i++) {
+      if (strcmp(argv[1], category_names[i]) == 0) {
+        audio_set_level(i, strtoul(argv[2], NULL, 0));
+        audio_save_settings();
+        return 0;
+      }
+    }
+    shell_error(sh, "Usage: badge audio [sfx|ui|music <0-%d>|bench [effect]]",
+                AUDIO_LEVEL_MAX);
+    return -EINVAL;
+  }
+
+  shell_print(sh, "Muted: %s, playing: %s, waiting: %d, on: %s",
+              atomic_get(&muted) ? "yes" : "no",
+              playing ? playing->name : "-", num_waiting,
+              on_mixer ? "mixer" : "tone");
+  shell_print(sh, "Levels (of %d): sfx %ld, ui %ld, music %ld%s",
+              AUDIO_LEVEL_MAX, (long)atomic_get(&levels[AUDIO_SFX]),
+              (long)atomic_get(&levels[AUDIO_UI]),
+              (long)atomic_get(&levels[AUDIO_MUSIC]),
+              k_uptime_get() < duck_until ? " (ducked)" : "");
+  shell_print(sh, "Played: %u", played);
+  shell_print(sh, "Preempted: %u, waited: %u, dropped: %ld", preempted,
+              waited, (long)atomic_get(&dropped));
+  shell_print(sh, "Slowest enqueue: %u us",
+              (uint32_t)k_cyc_to_us_ceil32(max_enqueue_cycles));
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), audio, NULL,
+                 "Audio engine state and counters, or set a volume level\n"
+                 "Usage: badge audio [sfx|ui|music <level>|bench [effect]]",
+                 cmd_audio, 1, 2);
@@ -0,0 +1,91 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include "app_shared.h"
+
+/*
+ * Audio engine. A dedicated thread owns the buzzer; play_beep_*() and
+ * audio_play_sfx() only push a command onto a lock-free single-producer
+ * ring (launcher thread) and return. An effect cuts off one of equal or
+ * lower priority that is playing, a lower one waits its turn. Between
+ * effects the thread sequences background music (music.h). Mute and the
+ * volume levels are applied inside the engine, so muted effects cost
+ * nothing but the enqueue.
+ */
+
+/*
+ * Volume per category, 0 (off) to AUDIO_LEVEL_MAX. On the mixer a level
+ * scales channel volume, on the tone backend pulse width (tone_set_gain()).
+ * Music ducks under game effects while they play.
+ */
+#define AUDIO_LEVEL_MAX 4
+
+typedef enum {
+  AUDIO_SFX,   // Game effects, the default for an SfxDef
+  AUDIO_UI,    // Menu clicks
+  AUDIO_MUSIC, // Songs (music.h)
+  AUDIO_CATEGORIES
+} AudioCategory;
+
+/*
+ * A sound effect is const data: a pitch sweep with an optional arpeggio on
+ * top, rendered in SFX_STEP_MS steps, each retuning the running tone from
+ * its next edge (one period a step on the busy-loop backend). The category
+ * level sets the volume on either output: on the tone backend through pulse
+ * width (tone_set_gain()), so the effect's own duty does not apply there.
+ * With the mixer the effect has its own pulse channel, which takes the duty
+ * and the volume envelope too.
+ */
+#define SFX_STEP_MS 1
+#define SFX_ARP_MAX 4
+
+typedef enum {
+  SFX_LINEAR_HZ,     // Frequency moves evenly from start to end
+  SFX_LINEAR_PERIOD, // Period does: slow at the low end, quick at the top
+} SfxCurve;
+
+typedef struct {
+  const char *name; // For "badge audio"
+  uint16_t start_hz;
+  uint16_t end_hz; // Same as start_hz for a fixed pitch
+  uint16_t duration_ms;
+  uint8_t curve;     // SfxCurve
+  uint8_t duty;      // Percent high, 0 = square (tone: from the level)
+  uint8_t volume;    // Peak, 0 = MIXER_MAX_VOLUME (mixer only)
+  uint8_t attack_ms; // Rise from silence (mixer only)
+  uint8_t decay_ms;  // Fall to silence at the end (mixer only)
+  uint8_t priority;
+  uint8_t arp_ms; // Time on each arpeggio step, 0 = no arpeggio
+  uint8_t arp_steps;
+  int8_t arp[SFX_ARP_MAX]; // Semitones added to the sweep, in turn
+  uint8_t category;        // AudioCategory
+} SfxDef;
+
+/* The launcher's shared effects, behind play_beep_*() */
+typedef enum { SFX_MOVE, SFX_EAT, SFX_DIE, SFX_COUNT } Sfx;
+
+void audio_play_sfx(const SfxDef *sfx);
+void audio_play(Sfx sfx);
+void audio_stop(void); // Silences the effect playing and drops queued ones
+void audio_wake(void); // Music (music.c) changed, reschedule the thread
+
+/* Launcher loop: queues the effects the shell asked for */
+void audio_poll(void);
+
+/*
+ * Shell thread: a fixed-pitch test tone at the sfx level that cuts off
+ * anything playing ("badge tone"). The launcher queues it, the ring's only
+ * producer; returns false if it did not within a second.
+ */
+bool audio_request_tone(uint16_t hz, uint16_t ms);
+
+void audio_set_muted(bool muted);
+bool audio_muted(void);
+
+void audio_set_level(AudioCategory category, uint8_t level);
+uint8_t audio_level(AudioCategory category);
+
+/* Stores mute and the levels with CONFIG_SETTINGS, loaded at boot */
+void audio_save_settings(void);
+
+#endif
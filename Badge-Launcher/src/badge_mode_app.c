@@ -34,19 +34,18 @@ static void update_lock_indicator(void) {
   }
 }
 
-static void badge_enter(void) {
-  lv_obj_clean(lv_scr_act());
+static void badge_enter(lv_obj_t *scr) {
   // Ensure solid white background
-  lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
 
   // 1. Full Screen Image
-  img_obj = lv_img_create(lv_scr_act());
+  img_obj = lv_img_create(scr);
   lv_obj_center(img_obj); // Center it (400x300 should fill screen)
   update_image();
 
   // 2. Lock Indicator "L"
-  lock_label = lv_label_create(lv_scr_act());
+  lock_label = lv_label_create(scr);
   lv_label_set_text(lock_label, "L");
   lv_obj_set_style_text_font(lock_label, &lv_font_montserrat_14,
                              0); // Small indicator
@@ -60,17 +59,12 @@ static void badge_enter(void) {
   update_lock_indicator();
 }
 
-static void badge_update(void) {
-  static int btn_left_prev = 0;
-  static int btn_right_prev = 0;
-  static int btn_select_prev = 0;
-
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right);
-  int btn_select_curr = gpio_pin_get_dt(&btn_select);
+static void badge_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
   // --- Select Button (Toggle Lock) ---
-  if (btn_select_curr && !btn_select_prev) {
+  if (evt->button == BTN_SELECT) {
     is_locked = !is_locked;
     update_lock_indicator();
     // Beep on lock toggle? Maybe minor beep
@@ -80,24 +74,20 @@ static void badge_update(void) {
   // --- Navigation (Only if Unlocked) ---
   if (!is_locked) {
     // Left
-    if (btn_left_curr && !btn_left_prev) {
+    if (evt->button == BTN_LEFT) {
       current_image_idx--;
       if (current_image_idx < 0)
         current_image_idx = NUM_BADGE_IMAGES - 1;
       update_image();
     }
     // Right
-    if (btn_right_curr && !btn_right_prev) {
+    if (evt->button == BTN_RIGHT) {
       current_image_idx++;
       if (current_image_idx >= NUM_BADGE_IMAGES)
         current_image_idx = 0;
       update_image();
     }
   }
-
-  btn_left_prev = btn_left_curr;
-  btn_right_prev = btn_right_curr;
-  btn_select_prev = btn_select_curr;
 }
 
 static void badge_exit(void) {
@@ -109,5 +99,6 @@ static void badge_exit(void) {
 
 App badge_mode_app = {.name = "Badge Mode",
                       .enter = badge_enter,
-                      .update = badge_update,
-                      .exit = badge_exit};
+                      .input = badge_input,
+                      .exit = badge_exit,
+                      .refresh = REFRESH_QUALITY};
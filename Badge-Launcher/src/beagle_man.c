@@ -1,5 +1,5 @@
 #include "beagle_man.h"
-#include <zephyr/random/random.h>
+#include "tile_map.h"
 
 LOG_MODULE_REGISTER(beagle_man, LOG_LEVEL_INF);
 
@@ -7,12 +7,14 @@ LOG_MODULE_REGISTER(beagle_man, LOG_LEVEL_INF);
 #define COLS 20
 #define ROWS 15
 #define CELL_SIZE 20
+#define TICK_MS 50
 
-// Map Tiles
-#define TILE_EMPTY 0
+// Map Tiles (TILE_EMPTY is 0, from the tile map)
 #define TILE_WALL 1
 #define TILE_DOT 2
-#define TILE_POWER 3 // Not used yet, maybe later
+#define TILE_POWER 3  // Not used yet, maybe later
+#define TILE_PLAYER 4 // Board only
+#define TILE_GHOST 5
 
 // Entities
 typedef struct {
@@ -29,7 +31,7 @@ static Entity ghost; // Single ghost for now
 static int score;
 static bool game_over;
 static bool win_state;
-static int64_t last_tick;
+static int move_timer; // ms accumulated towards the next step
 static int game_speed = 250;
 
 // Map (1 = Wall, 0 = Empty/Dot placeholder)
@@ -61,62 +63,64 @@ static const int initial_map[ROWS][COLS] = {
 static lv_obj_t *main_cont;
 static lv_obj_t *score_label;
 static lv_obj_t *game_over_label;
-static lv_obj_t *grid_cells[COLS][ROWS];
 
-static void set_cell_color(int x, int y, lv_color_t color) {
-  if (x >= 0 && x < COLS && y >= 0 && y < ROWS && grid_cells[x][y]) {
-    lv_obj_set_style_bg_color(grid_cells[x][y], color, 0);
-  }
-}
-
-// Draw a small dot? We can just use a grey color or checkerboard?
-// For pure grid: Wall=Black, Empty=White, Dot=Light Grey?
-// Or: Wall=Black, Dot=Small square?
-// Limitation: We are coloring the WHOLE cell.
-// Solution: Dot = Light Grey Cell. Wall = Black. Player = Dark Blue/Black?
-// Let's use:
-// Wall: BLACK
-// Empty: WHITE
-// Dot: GREY (lv_palette_lighten(LV_PALETTE_GREY, 2))
-// Player: RED (or Black if mono) -> Let's use Checkered or just Black/White.
-// E-Ink is mono (mostly).
-// Wall = Black.
-// Dot = Light Grey (Dithering) -> might look messy.
-// Let's allow Dot = White, Wall = Black.
-// Player = Black (Blinking?) or just Black.
-// Wait, if Player is Black and Wall is Black, how to distinguish?
-// Player = Inverted?
-// Let's make Walls GREY (Dithered Black) and Player/Ghost BLACK SOLID.
-// Dots: White? (Invisible?)
-// Actually, let's use: Wall = Black. Path = White. Dot = Small Black center?
-// We can't draw sub-pixel in this static grid engine.
-// Okay: Dot = Grey Cell. Player = Black. Wall = Black.
-// Player vs Wall collisions prevent overlap, so visuals are fine.
-// Dot vs Empty: Grey vs White.
+// Board: the map tiles plus the two entities, all readable in black on white
+static const uint8_t ghost_bits[] = {
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+    0x03, 0xfc, 0x00, // ...####...
+    0x03, 0xfc, 0x00,
+    0x0f, 0xff, 0x00, // ..######..
+    0x0f, 0xff, 0x00,
+    0x3f, 0xff, 0xc0, // .########.
+    0x3f, 0xff, 0xc0,
+    0x30, 0xf0, 0xc0, // .#..##..#.
+    0x30, 0xf0, 0xc0,
+    0x30, 0xf0, 0xc0, // .#..##..#.
+    0x30, 0xf0, 0xc0,
+    0x3f, 0xff, 0xc0, // .########.
+    0x3f, 0xff, 0xc0,
+    0x3f, 0xff, 0xc0, // .########.
+    0x3f, 0xff, 0xc0,
+    0x3f, 0xff, 0xc0, // .########.
+    0x3f, 0xff, 0xc0,
+    0x3c, 0xf3, 0xc0, // .##.##.##.
+    0x3c, 0xf3, 0xc0,
+};
+
+static const TileDef tiles[] = {
+    [TILE_WALL] = {.shape = TILE_FILL},
+    [TILE_DOT] = {.shape = TILE_FILL, .inset = 8},
+    [TILE_POWER] = {.shape = TILE_ROUND, .inset = 5},
+    [TILE_PLAYER] = {.shape = TILE_ROUND, .inset = 2},
+    [TILE_GHOST] = {.shape = TILE_SPRITE, .bits = ghost_bits},
+};
+static TileMap board;
 
 static void render_game(void) {
   for (int x = 0; x < COLS; x++) {
     for (int y = 0; y < ROWS; y++) {
-      lv_color_t color = lv_color_white();
+      uint8_t tile = TILE_EMPTY;
 
       // 1. Static Map
       if (map[x][y] == TILE_WALL) {
-        color = lv_color_black();
+        tile = TILE_WALL;
       } else if (dots[x][y]) {
-        color = lv_palette_lighten(LV_PALETTE_GREY, 2); // Dot
+        tile = TILE_DOT;
       }
 
       // 2. Entities
       if (x == player.x && y == player.y) {
-        color = lv_palette_main(LV_PALETTE_BLUE); // Player (Dark on mono)
+        tile = TILE_PLAYER;
       }
       if (x == ghost.x && y == ghost.y) {
-        color = lv_palette_main(LV_PALETTE_RED); // Ghost
+        tile = TILE_GHOST;
       }
 
-      set_cell_color(x, y, color);
+      tile_map_set(&board, x, y, tile);
     }
   }
+  tile_map_commit(&board);
 }
 
 static void reset_game(void) {
@@ -149,6 +153,7 @@ static void reset_game(void) {
   score = 0;
   game_over = false;
   win_state = false;
+  move_timer = 0;
 
   if (game_over_label)
     lv_obj_add_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
@@ -158,23 +163,15 @@ static void reset_game(void) {
   render_game();
 }
 
-static void beagle_man_enter(void) {
-  main_cont = lv_obj_create(lv_scr_act());
+static void beagle_man_enter(lv_obj_t *scr) {
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_scrollbar_mode(main_cont, LV_SCROLLBAR_MODE_OFF);
 
-  // Grid
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      lv_obj_t *cell = lv_obj_create(main_cont);
-      lv_obj_set_size(cell, CELL_SIZE, CELL_SIZE);
-      lv_obj_set_pos(cell, x * CELL_SIZE, y * CELL_SIZE);
-      lv_obj_set_style_border_width(cell, 0, 0);
-      lv_obj_set_style_radius(cell, 0, 0);
-      grid_cells[x][y] = cell;
-    }
-  }
+  // Board
+  tile_map_create(&board, main_cont, COLS, ROWS, CELL_SIZE, tiles,
+                  ARRAY_SIZE(tiles));
 
   // UI
   score_label = lv_label_create(main_cont);
@@ -196,7 +193,6 @@ static void beagle_man_enter(void) {
   lv_obj_set_style_bg_opa(game_over_label, LV_OPA_COVER, 0);
 
   reset_game();
-  last_tick = k_uptime_get();
 }
 
 static void try_move_entity(Entity *e) {
@@ -227,12 +223,12 @@ static void move_ghost_ai(void) {
   // 60% chance to chase, 40% random
   int tx, ty;
 
-  if (sys_rand32_get() % 100 < 60) {
+  if (app_rand32() % 100 < 60) {
     tx = player.x;
     ty = player.y;
   } else {
-    tx = sys_rand32_get() % COLS;
-    ty = sys_rand32_get() % ROWS;
+    tx = app_rand32() % COLS;
+    ty = app_rand32() % ROWS;
   }
 
   // Directions: Up, Down, Left, Right
@@ -265,78 +261,83 @@ static void move_ghost_ai(void) {
   }
 }
 
-static void beagle_man_update(void) {
-  int btn_up_curr = gpio_pin_get_dt(&btn_up);
-
-  // Use real Down button
-  int btn_down_curr = gpio_pin_get_dt(&btn_down);
+static void beagle_man_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right);
+  if (game_over) {
+    if (evt->button == BTN_UP) {
+      reset_game();
+    }
+    return;
+  }
 
-  // Input Buffering
-  if (btn_up_curr) {
+  // Input Buffering (latest press wins, applied on the next step)
+  switch (evt->button) {
+  case BTN_UP:
     player.next_dir_x = 0;
     player.next_dir_y = -1;
-  }
-  if (btn_down_curr) {
+    break;
+  case BTN_DOWN:
     player.next_dir_x = 0;
     player.next_dir_y = 1;
-  }
-  // Ignore Select for movement now
-  if (btn_left_curr) {
+    break;
+  case BTN_LEFT:
     player.next_dir_x = -1;
     player.next_dir_y = 0;
-  }
-  if (btn_right_curr) {
+    break;
+  case BTN_RIGHT:
     player.next_dir_x = 1;
     player.next_dir_y = 0;
+    break;
+  default:
+    // Ignore Select for movement now
+    break;
   }
+}
 
-  static int btn_up_prev_gm = 0;
-  if (game_over) {
-    if (btn_up_curr && !btn_up_prev_gm) {
-      reset_game();
-    }
-    btn_up_prev_gm = btn_up_curr;
+// Fixed 50ms tick, entities step once game_speed ms have accumulated
+static void beagle_man_tick(void) {
+  if (game_over)
     return;
-  }
-  btn_up_prev_gm = btn_up_curr;
-
-  int64_t now = k_uptime_get();
-  if (now - last_tick > game_speed) {
-
-    // 1. Move Player
-    try_move_entity(&player);
-
-    // 2. Eat Dot
-    if (dots[player.x][player.y]) {
-      dots[player.x][player.y] = false;
-      score += 10;
-      play_beep_eat();
-      lv_label_set_text_fmt(score_label, "Score: %d", score);
-      // Speed up?
-      if (score % 100 == 0 && game_speed > 150)
-        game_speed -= 10;
-    }
 
-    // 3. Move Ghost (Slower? No, same speed for tension)
-    // Move ghost every other tick? No, same speed.
-    move_ghost_ai();
+  move_timer += TICK_MS;
+  if (move_timer < game_speed)
+    return;
+  move_timer -= game_speed; // Keep the remainder so the average rate is exact
+
+  // 1. Move Player
+  try_move_entity(&player);
+
+  // 2. Eat Dot
+  if (dots[player.x][player.y]) {
+    dots[player.x][player.y] = false;
+    score += 10;
+    play_beep_eat();
+    lv_label_set_text_fmt(score_label, "Score: %d", score);
+    // Speed up?
+    if (score % 100 == 0 && game_speed > 150)
+      game_speed -= 10;
+  }
 
-    // 4. Collision
-    if (player.x == ghost.x && player.y == ghost.y) {
-      game_over = true;
-      play_beep_die();
-      lv_label_set_text(game_over_label, "GAME OVER\nUP to Restart");
-      lv_obj_clear_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
-    }
+  // 3. Move Ghost (Slower? No, same speed for tension)
+  // Move ghost every other tick? No, same speed.
+  move_ghost_ai();
 
-    render_game();
-    last_tick = now;
+  // 4. Collision
+  if (player.x == ghost.x && player.y == ghost.y) {
+    game_over = true;
+    play_beep_die();
+    lv_label_set_text(game_over_label, "GAME OVER\nUP to Restart");
+    lv_obj_clear_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
   }
+
+  render_game();
 }
 
+// Screen is retained, the maze continues where it was left
+static void beagle_man_resume(void) {}
+
 static void beagle_man_exit(void) {
   if (main_cont) {
     lv_obj_del(main_cont);
@@ -346,5 +347,9 @@ static void beagle_man_exit(void) {
 
 App beagle_man_app = {.name = "BeagleMan",
                       .enter = beagle_man_enter,
-                      .update = beagle_man_update,
-                      .exit = beagle_man_exit};
+                      .input = beagle_man_input,
+                      .exit = beagle_man_exit,
+                      .resume = beagle_man_resume,
+                      .tick_ms = TICK_MS,
+                      .tick = beagle_man_tick,
+                      .refresh = REFRESH_FAST};
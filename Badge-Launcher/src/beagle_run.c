@@ -1,5 +1,5 @@
 #include "beagle_run.h"
-#include <zephyr/random/random.h>
+#include "tile_map.h"
 
 LOG_MODULE_REGISTER(beagle_run, LOG_LEVEL_INF);
 
@@ -23,7 +23,6 @@ static int player_vy;
 static bool is_jumping;
 static int score;
 static bool game_over;
-static int64_t last_tick;
 
 typedef struct {
   int x;
@@ -38,18 +37,14 @@ static int next_spawn_distance;
 static lv_obj_t *main_cont;
 static lv_obj_t *score_label;
 static lv_obj_t *game_over_label;
-static lv_obj_t *grid_cells[COLS][ROWS]; // Static Grid
 
-// --- Input ---
-static int btn_up_prev = 0;
+// Board: player and obstacles are plain blocks
+#define TILE_BLOCK 1
 
-static void set_cell_color(int x, int y, lv_color_t color) {
-  if (x >= 0 && x < COLS && y >= 0 && y < ROWS && grid_cells[x][y]) {
-    lv_obj_set_style_bg_color(grid_cells[x][y], color, 0);
-  }
-}
+static const TileDef tiles[] = {[TILE_BLOCK] = {.shape = TILE_FILL}};
+static TileMap board;
 
-static void draw_rect_to_grid(int px, int py, int w, int h, lv_color_t color) {
+static void draw_rect_to_grid(int px, int py, int w, int h, uint8_t tile) {
   // Convert Pixel Rect to Grid Cells
   int start_col = px / CELL_SIZE;
   int end_col = (px + w - 1) / CELL_SIZE;
@@ -58,34 +53,32 @@ static void draw_rect_to_grid(int px, int py, int w, int h, lv_color_t color) {
 
   for (int c = start_col; c <= end_col; c++) {
     for (int r = start_row; r <= end_row; r++) {
-      set_cell_color(c, r, color);
+      tile_map_set(&board, c, r, tile);
     }
   }
 }
 
 static void render_game(void) {
   // 1. Clear Grid (White)
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      set_cell_color(x, y, lv_color_white());
-    }
-  }
+  tile_map_fill(&board, TILE_EMPTY);
 
   // 2. Draw Ground (Static Line handled in enter, not per-frame)
-  // draw_rect_to_grid(0, GROUND_Y, SCREEN_WIDTH, CELL_SIZE, lv_color_black());
+  // draw_rect_to_grid(0, GROUND_Y, SCREEN_WIDTH, CELL_SIZE, TILE_BLOCK);
 
   // 3. Draw Player
   // Player is CELL_SIZE x CELL_SIZE
   draw_rect_to_grid(PLAYER_X, player_y - CELL_SIZE, CELL_SIZE, CELL_SIZE,
-                    lv_color_black());
+                    TILE_BLOCK);
 
   // 4. Draw Obstacles
   for (int i = 0; i < MAX_OBSTACLES; i++) {
     if (obstacles[i].active) {
       draw_rect_to_grid(obstacles[i].x, GROUND_Y - CELL_SIZE, CELL_SIZE,
-                        CELL_SIZE, lv_color_black());
+                        CELL_SIZE, TILE_BLOCK);
     }
   }
+
+  tile_map_commit(&board);
 }
 
 static void reset_game(void) {
@@ -109,25 +102,16 @@ static void reset_game(void) {
   render_game();
 }
 
-static void beagle_run_enter(void) {
-  main_cont = lv_obj_create(lv_scr_act());
+static void beagle_run_enter(lv_obj_t *scr) {
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_scrollbar_mode(main_cont, LV_SCROLLBAR_MODE_OFF);
   lv_obj_clear_flag(main_cont, LV_OBJ_FLAG_SCROLLABLE);
 
-  // Create Static Grid
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      lv_obj_t *cell = lv_obj_create(main_cont);
-      lv_obj_set_size(cell, CELL_SIZE, CELL_SIZE);
-      lv_obj_set_pos(cell, x * CELL_SIZE, y * CELL_SIZE);
-      lv_obj_set_style_border_width(cell, 0, 0); // No Borders for seamless look
-      lv_obj_set_style_radius(cell, 0, 0);
-      lv_obj_set_style_bg_color(cell, lv_color_white(), 0);
-      grid_cells[x][y] = cell;
-    }
-  }
+  // Board
+  tile_map_create(&board, main_cont, COLS, ROWS, CELL_SIZE, tiles,
+                  ARRAY_SIZE(tiles));
 
   // Static Ground Line (Thinner, independent of grid)
   lv_obj_t *ground_line = lv_obj_create(main_cont);
@@ -135,7 +119,7 @@ static void beagle_run_enter(void) {
   lv_obj_set_pos(ground_line, 0, GROUND_Y);
   lv_obj_set_style_bg_color(ground_line, lv_color_black(), 0);
   lv_obj_set_style_border_width(ground_line, 0, 0);
-  lv_obj_move_foreground(ground_line); // On top of grid cells
+  lv_obj_move_foreground(ground_line); // On top of the board
 
   // Score Label (Overlay)
   score_label = lv_label_create(main_cont);
@@ -151,38 +135,27 @@ static void beagle_run_enter(void) {
   lv_obj_move_foreground(game_over_label); // Ensure on top of grid
 
   reset_game();
-  last_tick = k_uptime_get();
 }
 
-static void beagle_run_update(void) {
-  int btn_up_curr = gpio_pin_get_dt(&btn_up);
-
-  if (game_over) {
-    if (btn_up_curr && !btn_up_prev) {
+static void beagle_run_input(const ButtonEvent *evt) {
+  // --- Input (Jump / Restart) ---
+  if (evt->button == BTN_UP && evt->action == BTN_PRESSED) {
+    if (game_over) {
       reset_game();
+    } else if (!is_jumping && player_y >= GROUND_Y) {
+      // Integrated on the next tick
+      player_vy = JUMP_FORCE;
+      is_jumping = true;
     }
-    btn_up_prev = btn_up_curr;
-    return;
   }
+}
 
-  // Loop Interval: 50ms = 20 FPS (Good for discrete stepping if speed is high)
-  // If we want 1-cell moves:
-  // With Speed 20px, 50ms -> 400px/s -> 1 screen/s.
-  int64_t now = k_uptime_get();
-  if (now - last_tick < 50)
+// Tick Interval: 50ms = 20 FPS (Good for discrete stepping if speed is high)
+// If we want 1-cell moves:
+// With Speed 20px, 50ms -> 400px/s -> 1 screen/s.
+static void beagle_run_tick(void) {
+  if (game_over)
     return;
-  last_tick = now;
-
-  // --- Input (Jump) ---
-  if (btn_up_curr && !btn_up_prev) {
-    if (!is_jumping) {
-      if (player_y >= GROUND_Y) {
-        player_vy = JUMP_FORCE;
-        is_jumping = true;
-      }
-    }
-  }
-  btn_up_prev = btn_up_curr;
 
   // --- Physics ---
   player_y += player_vy;
@@ -202,7 +175,7 @@ static void beagle_run_update(void) {
         obstacles[i].active = true;
         obstacles[i].x = SCREEN_WIDTH + CELL_SIZE; // Start offscreen
         // Random spawn 200-600px
-        next_spawn_distance = 200 + (sys_rand32_get() % 400);
+        next_spawn_distance = 200 + (app_rand32() % 400);
         break;
       }
     }
@@ -243,6 +216,9 @@ static void beagle_run_update(void) {
   render_game();
 }
 
+// Screen is retained, the run continues where it was left
+static void beagle_run_resume(void) {}
+
 static void beagle_run_exit(void) {
   if (main_cont) {
     lv_obj_del(main_cont);
@@ -252,5 +228,9 @@ static void beagle_run_exit(void) {
 
 App beagle_run_app = {.name = "Beagle Run",
                       .enter = beagle_run_enter,
-                      .update = beagle_run_update,
-                      .exit = beagle_run_exit};
+                      .input = beagle_run_input,
+                      .exit = beagle_run_exit,
+                      .resume = beagle_run_resume,
+                      .tick_ms = 50,
+                      .tick = beagle_run_tick,
+                      .refresh = REFRESH_FAST};
@@ -32,8 +32,6 @@ static Tamagotchi pet = {.hunger = 80,
                          .is_eating = false,
                          .is_playing = false};
 
-static int64_t last_tick;
-static int64_t last_input_time;
 
 /* Menu System */
 typedef enum { ACTION_FEED, ACTION_PLAY, ACTION_SLEEP, NUM_ACTIONS } ActionType;
@@ -207,13 +205,12 @@ static lv_obj_t *create_stat_bar(const char *label_text, int y_pos) {
   return bar;
 }
 
-static void beaglegotchi_enter(void) {
-  lv_obj_clean(lv_scr_act());
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
-  lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
+static void beaglegotchi_enter(lv_obj_t *scr) {
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
 
   // --- Status Bar (Top Right) ---
-  lbl_status = lv_label_create(lv_scr_act());
+  lbl_status = lv_label_create(scr);
   lv_label_set_text(lbl_status, "Ready!");
   lv_obj_set_style_text_color(lbl_status, lv_color_black(), 0);
   // Fix for ghosting: Set opaque white background AND fixed width to cover all
@@ -233,13 +230,13 @@ static void beaglegotchi_enter(void) {
   bar_happy = create_stat_bar("Happy", 85);
 
   // --- Sprite (Center, slightly pushed down to clear bars) ---
-  img_sprite = lv_img_create(lv_scr_act());
+  img_sprite = lv_img_create(scr);
   lv_img_set_src(img_sprite, &standard);
   lv_obj_align(img_sprite, LV_ALIGN_CENTER, 20,
                10); // Shift right/down slightly
 
   // --- Action Menu (Bottom) ---
-  menu_container = lv_obj_create(lv_scr_act());
+  menu_container = lv_obj_create(scr);
   lv_obj_set_size(menu_container, 350, 40);
   lv_obj_align(menu_container, LV_ALIGN_BOTTOM_MID, 0, -20);
   lv_obj_set_flex_flow(menu_container, LV_FLEX_FLOW_ROW);
@@ -256,7 +253,7 @@ static void beaglegotchi_enter(void) {
   }
 
   // --- Tooltip (Very Bottom) ---
-  lbl_tooltip = lv_label_create(lv_scr_act());
+  lbl_tooltip = lv_label_create(scr);
   lv_label_set_text(lbl_tooltip, "[< >] Move   [Select] Act");
   lv_obj_set_style_text_font(lbl_tooltip, &lv_font_montserrat_14, 0);
   lv_obj_set_style_text_color(lbl_tooltip, lv_color_black(), 0);
@@ -267,40 +264,27 @@ static void beaglegotchi_enter(void) {
   update_sprite();
   update_bars();
   update_status_text();
-
-  last_tick = k_uptime_get();
-  last_input_time = k_uptime_get();
 }
 
-static void beaglegotchi_update(void) {
-  int64_t now = k_uptime_get();
-
-  // Input Handling (Debounced 200ms)
-  if (now - last_input_time > 200) {
-    if (gpio_pin_get_dt(&btn_left)) {
-      selected_action--;
-      if (selected_action < 0)
-        selected_action = NUM_ACTIONS - 1;
-      update_menu();
-      play_beep_move();
-      last_input_time = now;
-    } else if (gpio_pin_get_dt(&btn_right)) {
-      selected_action++;
-      if (selected_action >= NUM_ACTIONS)
-        selected_action = 0;
-      update_menu();
-      play_beep_move();
-      last_input_time = now;
-    } else if (gpio_pin_get_dt(&btn_select)) {
-      perform_action();
-      last_input_time = now;
-    }
-  }
+static void beaglegotchi_input(const ButtonEvent *evt) {
+  // Held buttons keep acting on auto-repeat
+  if (evt->action != BTN_PRESSED && evt->action != BTN_REPEAT)
+    return;
 
-  // Game Loop (1s Tick)
-  if (now - last_tick > TICK_INTERVAL) {
-    game_tick();
-    last_tick = now;
+  if (evt->button == BTN_LEFT) {
+    selected_action--;
+    if (selected_action < 0)
+      selected_action = NUM_ACTIONS - 1;
+    update_menu();
+    play_beep_move();
+  } else if (evt->button == BTN_RIGHT) {
+    selected_action++;
+    if (selected_action >= NUM_ACTIONS)
+      selected_action = 0;
+    update_menu();
+    play_beep_move();
+  } else if (evt->button == BTN_SELECT) {
+    perform_action();
   }
 }
 
@@ -310,5 +294,7 @@ static void beaglegotchi_exit(void) {
 
 App beaglegotchi_app = {.name = "Beaglegotchi",
                         .enter = beaglegotchi_enter,
-                        .update = beaglegotchi_update,
-                        .exit = beaglegotchi_exit};
+                        .input = beaglegotchi_input,
+                        .exit = beaglegotchi_exit,
+                        .tick_ms = TICK_INTERVAL, // Game Loop (1s Tick)
+                        .tick = game_tick};
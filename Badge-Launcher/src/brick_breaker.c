@@ -1,5 +1,6 @@
 #include "brick_breaker.h"
-#include <zephyr/random/random.h>
+#include "audio.h"
+#include "tile_map.h"
 
 LOG_MODULE_REGISTER(brick_breaker, LOG_LEVEL_INF);
 
@@ -10,9 +11,38 @@ LOG_MODULE_REGISTER(brick_breaker, LOG_LEVEL_INF);
 #define COLS (SCREEN_WIDTH / CELL_SIZE)
 #define ROWS (SCREEN_HEIGHT / CELL_SIZE)
 
+#define TICK_MS 50
+#define PADDLE_TICKS 2 // Paddle steps every 100ms while held
+#define BALL_TICKS 3   // Ball steps every 150ms
+
 #define PADDLE_Y (ROWS - 1)
 #define MAX_BRICKS (COLS * 5) // Top 5 rows
 
+// --- Sounds ---
+static const SfxDef sfx_launch = {.name = "launch",
+                                  .start_hz = 300,
+                                  .end_hz = 900,
+                                  .duration_ms = 80,
+                                  .duty = 25};
+
+static const SfxDef sfx_paddle = {.name = "paddle",
+                                  .start_hz = 440,
+                                  .end_hz = 440,
+                                  .duration_ms = 25,
+                                  .decay_ms = 15};
+
+// Major chord arpeggio
+static const SfxDef sfx_brick = {.name = "brick",
+                                 .start_hz = 880,
+                                 .end_hz = 880,
+                                 .duration_ms = 60,
+                                 .duty = 25,
+                                 .decay_ms = 20,
+                                 .priority = 1,
+                                 .arp_ms = 20,
+                                 .arp_steps = 3,
+                                 .arp = {0, 4, 7}};
+
 // --- Game State ---
 static int paddle_x;         // Center col of paddle
 static int paddle_width = 3; // 3 cells wide
@@ -23,7 +53,7 @@ static int ball_dy;
 static int score;
 static bool game_over;
 static bool waiting_to_start;
-static int64_t last_tick;
+static int tick_count;
 
 typedef struct {
   int x;
@@ -37,55 +67,50 @@ static Brick bricks[MAX_BRICKS];
 static lv_obj_t *main_cont;
 static lv_obj_t *score_label;
 static lv_obj_t *game_over_label;
-static lv_obj_t *grid_cells[COLS][ROWS]; // Static Grid
 
-// --- Input ---
-static int btn_up_prev = 0;
-static int btn_select_prev = 0;
+// Board
+#define TILE_BLOCK 1 // Paddle and bricks
+#define TILE_BALL 2
 
-static void set_cell_color(int x, int y, lv_color_t color) {
-  if (x >= 0 && x < COLS && y >= 0 && y < ROWS && grid_cells[x][y]) {
-    lv_obj_set_style_bg_color(grid_cells[x][y], color, 0);
-  }
-}
+static const TileDef tiles[] = {
+    [TILE_BLOCK] = {.shape = TILE_FILL},
+    [TILE_BALL] = {.shape = TILE_ROUND},
+};
+static TileMap board;
+
+// --- Input ---
+// Left/Right move while held; a tap between paddle steps still moves once
+static bool left_tapped;
+static bool right_tapped;
 
 static void render_game(void) {
-  // 1. Clear Grid (White) and Reset Shape
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      if (grid_cells[x][y]) {
-        lv_obj_set_style_bg_color(grid_cells[x][y], lv_color_white(), 0);
-        lv_obj_set_style_radius(grid_cells[x][y], 0, 0); // Reset to square
-      }
-    }
-  }
+  // 1. Clear Grid (White)
+  tile_map_fill(&board, TILE_EMPTY);
 
   // 2. Paddle (Centered at paddle_x, width is odd)
   int offset = paddle_width / 2;
   for (int i = -offset; i <= offset; i++) {
-    set_cell_color(paddle_x + i, PADDLE_Y, lv_color_black());
+    tile_map_set(&board, paddle_x + i, PADDLE_Y, TILE_BLOCK);
   }
 
   // 3. Bricks
   for (int i = 0; i < MAX_BRICKS; i++) {
     if (bricks[i].active) {
-      set_cell_color(bricks[i].x, bricks[i].y, lv_color_black());
+      tile_map_set(&board, bricks[i].x, bricks[i].y, TILE_BLOCK);
     }
   }
 
   // 4. Ball (Round)
-  if (ball_x >= 0 && ball_x < COLS && ball_y >= 0 && ball_y < ROWS &&
-      grid_cells[ball_x][ball_y]) {
-    lv_obj_set_style_bg_color(grid_cells[ball_x][ball_y], lv_color_black(), 0);
-    lv_obj_set_style_radius(grid_cells[ball_x][ball_y], LV_RADIUS_CIRCLE, 0);
-  }
+  tile_map_set(&board, ball_x, ball_y, TILE_BALL);
+
+  tile_map_commit(&board);
 }
 
 static void reset_game(void) {
   paddle_x = COLS / 2;
   ball_x = paddle_x;
   ball_y = PADDLE_Y - 1;
-  ball_dx = (sys_rand32_get() % 2 == 0) ? 1 : -1;
+  ball_dx = (app_rand32() % 2 == 0) ? 1 : -1;
   ball_dy = -1; // Start moving up
   score = 0;
   game_over = false;
@@ -115,25 +140,16 @@ static void reset_game(void) {
   render_game();
 }
 
-static void brick_breaker_enter(void) {
-  main_cont = lv_obj_create(lv_scr_act());
+static void brick_breaker_enter(lv_obj_t *scr) {
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_scrollbar_mode(main_cont, LV_SCROLLBAR_MODE_OFF);
   lv_obj_clear_flag(main_cont, LV_OBJ_FLAG_SCROLLABLE);
 
-  // Create Static Grid
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      lv_obj_t *cell = lv_obj_create(main_cont);
-      lv_obj_set_size(cell, CELL_SIZE, CELL_SIZE);
-      lv_obj_set_pos(cell, x * CELL_SIZE, y * CELL_SIZE);
-      lv_obj_set_style_border_width(cell, 0, 0);
-      lv_obj_set_style_radius(cell, 0, 0);
-      lv_obj_set_style_bg_color(cell, lv_color_white(), 0);
-      grid_cells[x][y] = cell;
-    }
-  }
+  // Board
+  tile_map_create(&board, main_cont, COLS, ROWS, CELL_SIZE, tiles,
+                  ARRAY_SIZE(tiles));
 
   // Score Label
   score_label = lv_label_create(main_cont);
@@ -149,121 +165,118 @@ static void brick_breaker_enter(void) {
   lv_obj_move_foreground(game_over_label);
 
   reset_game();
-  last_tick = k_uptime_get();
 }
 
-static void brick_breaker_update(void) {
-  int btn_up_curr = gpio_pin_get_dt(&btn_up);
+static void brick_breaker_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
   if (game_over) {
-    if (btn_up_curr && !btn_up_prev) {
+    if (evt->button == BTN_UP) {
       reset_game();
     }
-    btn_up_prev = btn_up_curr;
     return;
   }
 
-  int64_t now = k_uptime_get();
+  if (evt->button == BTN_LEFT)
+    left_tapped = true;
+  if (evt->button == BTN_RIGHT)
+    right_tapped = true;
 
-  // --- Input (Paddle Move) ---
-  // Fast polling for responsiveness
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right);
+  // Select Button for Launch
+  if (waiting_to_start && evt->button == BTN_SELECT) {
+    waiting_to_start = false;
+    audio_play_sfx(&sfx_launch);
+  }
+}
 
+// --- Game Logic (Fixed 50ms Tick) ---
+static void brick_breaker_tick(void) {
+  if (game_over)
+    return;
+
+  tick_count++;
   int offset = paddle_width / 2;
 
-  if (now - last_tick > 80) { // Throttle input slightly but keep it fast
-    if (btn_left_curr && paddle_x > offset)
+  // --- Input (Paddle Move, held) ---
+  if (tick_count % PADDLE_TICKS == 0) {
+    if ((left_tapped || button_held(BTN_LEFT)) && paddle_x > offset)
       paddle_x--;
-    if (btn_right_curr && paddle_x < COLS - 1 - offset)
+    if ((right_tapped || button_held(BTN_RIGHT)) &&
+        paddle_x < COLS - 1 - offset)
       paddle_x++;
+    left_tapped = false;
+    right_tapped = false;
   }
 
-  // --- Physics (Ball Logic) ---
-  // Update ball every 150ms (Medium speed)
-  static int64_t last_ball_tick = 0;
-
-  // Select Button for Launch
-  int btn_select_curr = gpio_pin_get_dt(&btn_select);
   if (waiting_to_start) {
-    // Ball follows paddle
+    // Ball follows paddle, render every tick for smooth paddle/ball follow
     ball_x = paddle_x;
     ball_y = PADDLE_Y - 1;
+    render_game();
+    return;
+  }
 
-    if (btn_select_curr && !btn_select_prev) {
-      waiting_to_start = false;
-      play_beep_move(); // Sound effect for launch
-    }
-
-    // Still render to show paddle movement and ball following
-    // But don't throttle render too much if possible? The main loop is fast
-    // enough. Actually we need to call render_game() somewhere if paddle moves?
-    // render_game() is called inside the physics block usually.
-    // Let's call it here too if waiting.
-    if (now - last_ball_tick >
-        50) { // Render faster for smooth paddle/ball follow
-      render_game();
-      last_ball_tick = now;
-    }
+  // --- Physics (Ball Logic, Medium speed) ---
+  if (tick_count % BALL_TICKS != 0)
+    return;
 
-  } else if (now - last_ball_tick > 150) {
-    last_ball_tick = now;
+  int next_x = ball_x + ball_dx;
+  int next_y = ball_y + ball_dy;
 
-    int next_x = ball_x + ball_dx;
-    int next_y = ball_y + ball_dy;
+  // Wall Collision (X)
+  if (next_x < 0 || next_x >= COLS) {
+    ball_dx = -ball_dx;
+    next_x = ball_x + ball_dx; // Bounce back immediately
+  }
 
-    // Wall Collision (X)
-    if (next_x < 0 || next_x >= COLS) {
-      ball_dx = -ball_dx;
-      next_x = ball_x + ball_dx; // Bounce back immediately
-    }
+  // Wall Collision (Top Y)
+  if (next_y < 0) {
+    ball_dy = -ball_dy;
+    next_y = ball_y + ball_dy;
+  }
 
-    // Wall Collision (Top Y)
-    if (next_y < 0) {
-      ball_dy = -ball_dy;
+  // Paddle Collision
+  if (next_y >= PADDLE_Y) { // Reached bottom row
+    // Check if within paddle range
+    if (next_x >= paddle_x - offset && next_x <= paddle_x + offset) {
+      ball_dy = -ball_dy; // Bounce Up
       next_y = ball_y + ball_dy;
+      audio_play_sfx(&sfx_paddle);
+
+      // Angle change? (Simple physics for grid: randomized reflection?)
+      // Maybe if hitting edges of paddle, angle changes?
+      // Grid is too coarse for complex angles, just keep simple 45 deg.
+    } else {
+      // Missed -> Game Over
+      game_over = true;
+      lv_obj_clear_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
     }
+  }
 
-    // Paddle Collision
-    if (next_y >= PADDLE_Y) { // Reached bottom row
-      // Check if within paddle range
-      if (next_x >= paddle_x - offset && next_x <= paddle_x + offset) {
-        ball_dy = -ball_dy; // Bounce Up
-        next_y = ball_y + ball_dy;
-        play_beep_move();
-
-        // Angle change? (Simple physics for grid: randomized reflection?)
-        // Maybe if hitting edges of paddle, angle changes?
-        // Grid is too coarse for complex angles, just keep simple 45 deg.
-      } else {
-        // Missed -> Game Over
-        game_over = true;
-        lv_obj_clear_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
-      }
-    }
-
-    // Brick Collision
-    for (int i = 0; i < MAX_BRICKS; i++) {
-      if (bricks[i].active && bricks[i].x == next_x && bricks[i].y == next_y) {
-        bricks[i].active = false;
-        ball_dy = -ball_dy; // Bounce vertically (simple assumption)
-        next_y = ball_y + ball_dy;
-        score += 10;
-        play_beep_eat();
-        lv_label_set_text_fmt(score_label, "Score: %d", score);
-        break; // Only hit one brick per frame
-      }
+  // Brick Collision
+  for (int i = 0; i < MAX_BRICKS; i++) {
+    if (bricks[i].active && bricks[i].x == next_x && bricks[i].y == next_y) {
+      bricks[i].active = false;
+      ball_dy = -ball_dy; // Bounce vertically (simple assumption)
+      next_y = ball_y + ball_dy;
+      score += 10;
+      audio_play_sfx(&sfx_brick);
+      lv_label_set_text_fmt(score_label, "Score: %d", score);
+      break; // Only hit one brick per frame
     }
+  }
 
-    ball_x = next_x;
-    ball_y = next_y;
+  ball_x = next_x;
+  ball_y = next_y;
 
-    render_game();
-  }
-  btn_select_prev = btn_select_curr;
+  render_game();
+}
 
-  last_tick = now;
-  btn_up_prev = btn_up_curr;
+// Screen is retained, the game continues where it was left
+static void brick_breaker_resume(void) {
+  left_tapped = false;
+  right_tapped = false;
 }
 
 static void brick_breaker_exit(void) {
@@ -273,7 +286,15 @@ static void brick_breaker_exit(void) {
   }
 }
 
+/* Steering reads the held level every tick: no repeats or long presses */
+static const ButtonTiming brick_breaker_buttons = {0};
+
 App brick_breaker_app = {.name = "Brick Breaker",
                          .enter = brick_breaker_enter,
-                         .update = brick_breaker_update,
-                         .exit = brick_breaker_exit};
+                         .input = brick_breaker_input,
+                         .exit = brick_breaker_exit,
+                         .resume = brick_breaker_resume,
+                         .tick_ms = TICK_MS,
+                         .tick = brick_breaker_tick,
+                         .buttons = &brick_breaker_buttons,
+                         .refresh = REFRESH_FAST};
@@ -9,6 +9,7 @@ static lv_obj_t *label_left;
 static lv_obj_t *label_right;
 static lv_obj_t *label_select;
 static lv_obj_t *label_back;
+static lv_obj_t *label_gesture; // Last repeat/long press/chord
 
 /* State */
 static bool state_up = false;
@@ -37,44 +38,48 @@ static void update_ui(void) {
   update_label(label_back, state_back_btn);
 }
 
-static void button_test_enter(void) {
-  lv_obj_clean(lv_scr_act());
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+static void button_test_enter(lv_obj_t *scr) {
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
 
-  lv_obj_t *title = lv_label_create(lv_scr_act());
+  lv_obj_t *title = lv_label_create(scr);
   lv_label_set_text(title, "Button Test");
   lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 0);
 
   // UP
-  label_up = lv_label_create(lv_scr_act());
+  label_up = lv_label_create(scr);
   lv_label_set_text(label_up, "UP");
   lv_obj_align(label_up, LV_ALIGN_TOP_MID, 0, 30);
 
   // DOWN
-  label_down = lv_label_create(lv_scr_act());
+  label_down = lv_label_create(scr);
   lv_label_set_text(label_down, "DOWN");
   lv_obj_align(label_down, LV_ALIGN_BOTTOM_MID, 0, -30);
 
   // LEFT
-  label_left = lv_label_create(lv_scr_act());
+  label_left = lv_label_create(scr);
   lv_label_set_text(label_left, "LEFT");
   lv_obj_align(label_left, LV_ALIGN_LEFT_MID, 20, 0);
 
   // RIGHT
-  label_right = lv_label_create(lv_scr_act());
+  label_right = lv_label_create(scr);
   lv_label_set_text(label_right, "RIGHT");
   lv_obj_align(label_right, LV_ALIGN_RIGHT_MID, -20, 0);
 
   // SELECT
-  label_select = lv_label_create(lv_scr_act());
+  label_select = lv_label_create(scr);
   lv_label_set_text(label_select, "SELECT");
   lv_obj_align(label_select, LV_ALIGN_CENTER, 0, 0);
 
   // BACK
-  label_back = lv_label_create(lv_scr_act());
+  label_back = lv_label_create(scr);
   lv_label_set_text(label_back, "BACK");
   lv_obj_align(label_back, LV_ALIGN_TOP_LEFT, 5, 5);
 
+  // Gestures from the shared input layer
+  label_gesture = lv_label_create(scr);
+  lv_label_set_text(label_gesture, "");
+  lv_obj_align(label_gesture, LV_ALIGN_BOTTOM_MID, 0, -5);
+
   // Run Startup LED Sequence
   if (gpio_is_ready_dt(&led_red)) {
     gpio_pin_set_dt(&led_red, 1);
@@ -93,96 +98,87 @@ static void button_test_enter(void) {
   }
 }
 
-/* Debounce Logic */
-#define DEBOUNCE_MS 50
-static int64_t last_change_time[6]; // Up, Down, Left, Right, Select, Back
-static bool stable_states[6];
-
-// Indices
-enum {
-  BTN_IDX_UP = 0,
-  BTN_IDX_DOWN,
-  BTN_IDX_LEFT,
-  BTN_IDX_RIGHT,
-  BTN_IDX_SELECT,
-  BTN_IDX_BACK
-};
-
-static void handle_button_change(int btn_idx, bool pressed) {
+static void handle_button_change(Button btn, bool pressed) {
   // UI Updates
-  switch (btn_idx) {
-  case BTN_IDX_UP:
+  switch (btn) {
+  case BTN_UP:
     update_label(label_up, pressed);
     break;
-  case BTN_IDX_DOWN:
+  case BTN_DOWN:
     update_label(label_down, pressed);
     break;
-  case BTN_IDX_LEFT:
+  case BTN_LEFT:
     update_label(label_left, pressed);
     break;
-  case BTN_IDX_RIGHT:
+  case BTN_RIGHT:
     update_label(label_right, pressed);
     break;
-  case BTN_IDX_SELECT:
+  case BTN_SELECT:
     update_label(label_select, pressed);
     break;
-  case BTN_IDX_BACK:
+  case BTN_BACK:
     update_label(label_back, pressed);
     break;
+  default:
+    break;
   }
 
   // LED Updates (While Held)
-  if (btn_idx == BTN_IDX_UP && gpio_is_ready_dt(&led_green)) {
+  if (btn == BTN_UP && gpio_is_ready_dt(&led_green)) {
     gpio_pin_set_dt(&led_green, pressed);
   }
-  if (btn_idx == BTN_IDX_LEFT && gpio_is_ready_dt(&led_red)) {
+  if (btn == BTN_LEFT && gpio_is_ready_dt(&led_red)) {
     gpio_pin_set_dt(&led_red, pressed);
   }
-  if (btn_idx == BTN_IDX_RIGHT && gpio_is_ready_dt(&led_blue)) {
+  if (btn == BTN_RIGHT && gpio_is_ready_dt(&led_blue)) {
     gpio_pin_set_dt(&led_blue, pressed);
   }
 
   // Beep (Only on Press)
   if (pressed) {
-    if (btn_idx == BTN_IDX_LEFT)
+    if (btn == BTN_LEFT)
       play_beep_move(); // Use shared sounds
-    else if (btn_idx == BTN_IDX_RIGHT)
+    else if (btn == BTN_RIGHT)
       play_beep_move();
     else
       play_beep_eat(); // Default sound
   }
 }
 
-static void process_button(int btn_idx, const struct gpio_dt_spec *spec) {
-  if (!spec)
-    return;
-
-  int raw_state = gpio_pin_get_dt(spec);
-  int64_t now = k_uptime_get();
+static void show_gesture(const ButtonEvent *evt) {
+  char text[64];
+  int len = 0;
 
-  if (raw_state != stable_states[btn_idx]) {
-    if (now - last_change_time[btn_idx] > DEBOUNCE_MS) {
-      stable_states[btn_idx] = raw_state;
-      last_change_time[btn_idx] = now;
-      handle_button_change(btn_idx, raw_state);
+  switch (evt->action) {
+  case BTN_REPEAT:
+    snprintf(text, sizeof(text), "%s repeat x%u", button_name(evt->button),
+             evt->steps);
+    break;
+  case BTN_LONG_PRESS:
+    snprintf(text, sizeof(text), "%s long press", button_name(evt->button));
+    break;
+  case BTN_CHORD:
+    text[0] = '\0';
+    for (int i = 0; i < BTN_COUNT; i++) {
+      if (evt->held & BIT(i))
+        len += snprintf(text + len, sizeof(text) - len, "%s%s",
+                        len ? "+" : "", button_name(i));
     }
-  } else {
-    // Reset timer if signal matches stable state (glitch rejection)
-    // Actually, for simple debounce, we just wait for stable transition.
-    // If it bounces back, the next check will catch it if > 50ms.
-    // A more robust way is to update 'last_change' on ANY raw change,
-    // effectively requiring signal stability.
-    // But simple timeout is usually fine for buttons.
+    break;
+  default:
+    return;
   }
+  lv_label_set_text(label_gesture, text);
 }
 
-static void button_test_update(void) {
-  process_button(BTN_IDX_UP, &btn_up);
-  process_button(BTN_IDX_DOWN, &btn_down);
-  process_button(BTN_IDX_LEFT, &btn_left);
-  process_button(BTN_IDX_RIGHT, &btn_right);
-  process_button(BTN_IDX_SELECT, &btn_select);
-  process_button(BTN_IDX_BACK, &btn_back);
+static void button_test_input(const ButtonEvent *evt) {
+  // Edges arrive debounced from the input driver
+  if (evt->action != BTN_PRESSED && evt->action != BTN_RELEASED) {
+    show_gesture(evt);
+    return;
+  }
+
+  handle_button_change(evt->button, evt->action == BTN_PRESSED);
 }
 
 static void button_test_exit(void) {
@@ -199,5 +195,5 @@ static void button_test_exit(void) {
 
 App button_test_app = {.name = "Button Test",
                        .enter = button_test_enter,
-                       .update = button_test_update,
+                       .input = button_test_input,
                        .exit = button_test_exit};
@@ -0,0 +1,249 @@
+#include "buttons.h"
+#include "event_loop.h"
+#include "input_log.h"
+
+#include <string.h>
+#ifndef CONFIG_BADGE_BUTTON_DEBOUNCE
+#include <zephyr/input/input.h>
+#endif
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+static const char *const button_names[BTN_COUNT] = {
+    "up", "down", "left", "right", "select", "back"};
+
+#define EVENT_QUEUE_DEPTH 16
+
+K_MSGQ_DEFINE(button_msgq, sizeof(ButtonEvent), EVENT_QUEUE_DEPTH, 8);
+
+static atomic_t held_mask;  // Bit per Button, updated from the input thread
+static atomic_t dropped;    // Edges lost to a full queue
+static atomic_t live_muted; // Replay owns the queue, hardware is ignored
+
+/* Launcher defaults for apps without their own App.buttons */
+static const ButtonTiming default_timing = {
+    .repeat_delay_ms = BUTTON_REPEAT_DELAY_MS,
+    .repeat_interval_ms = BUTTON_REPEAT_INTERVAL_MS,
+    .repeat_min_ms = BUTTON_REPEAT_MIN_MS,
+    .repeat_accel_pct = BUTTON_REPEAT_ACCEL_PCT,
+    .long_press_ms = BUTTON_LONG_PRESS_MS,
+    .chord_mask = BIT_MASK(BTN_COUNT),
+};
+
+static const ButtonTiming *timing = &default_timing;
+
+/* Gesture state, launcher thread only */
+typedef struct {
+  int64_t repeat_at; // Next BTN_REPEAT, 0 = not repeating
+  uint32_t gap_ms;   // Gap that follows it
+  int64_t long_at;   // BTN_LONG_PRESS deadline, 0 = none pending
+} Gesture;
+
+static Gesture gestures[BTN_COUNT];
+static uint8_t down; // Buttons down as seen through the queue
+static ButtonEvent chord_event;
+static bool chord_ready; // chord_event goes out on the next call
+
+bool button_held(Button btn) { return atomic_test_bit(&held_mask, btn); }
+
+const char *button_name(Button btn) {
+  return btn < BTN_COUNT ? button_names[btn] : "?";
+}
+
+static void queue_edge(Button btn, bool pressed, int64_t uptime_ms,
+                       uint64_t edge_cycles) {
+  ButtonEvent be = {
+      .uptime_ms = uptime_ms,
+      .edge_cycles = edge_cycles,
+      .button = btn,
+      .action = pressed ? BTN_PRESSED : BTN_RELEASED,
+  };
+
+  if (pressed)
+    atomic_set_bit(&held_mask, btn);
+  else
+    atomic_clear_bit(&held_mask, btn);
+
+  if (k_msgq_put(&button_msgq, &be, K_NO_WAIT) != 0)
+    atomic_inc(&dropped);
+  event_loop_post_input();
+}
+
+void buttons_report_edge(Button btn, bool pressed, uint64_t edge_cycles) {
+  if (!atomic_get(&live_muted))
+    queue_edge(btn, pressed, app_uptime_get(), edge_cycles);
+}
+
+#ifndef CONFIG_BADGE_BUTTON_DEBOUNCE
+/* Input codes from the gpio-keys nodes behind the btn-* aliases */
+static const uint16_t button_codes[BTN_COUNT] = {
+    [BTN_UP] = DT_PROP(DT_ALIAS(btn_up), zephyr_code),
+    [BTN_DOWN] = DT_PROP(DT_ALIAS(btn_down), zephyr_code),
+    [BTN_LEFT] = DT_PROP(DT_ALIAS(btn_left), zephyr_code),
+    [BTN_RIGHT] = DT_PROP(DT_ALIAS(btn_right), zephyr_code),
+    [BTN_SELECT] = DT_PROP(DT_ALIAS(btn_select), zephyr_code),
+    [BTN_BACK] = DT_PROP(DT_ALIAS(btn_back), zephyr_code),
+};
+
+/*
+ * gpio-keys reports a key once it has been stable for the debounce interval,
+ * so the edge itself happened that long before the callback runs.
+ */
+#define KEY_DEBOUNCE_MS(alias)                                                 \
+  DT_PROP_OR(DT_PARENT(DT_ALIAS(alias)), debounce_interval_ms, 0)
+
+static const uint16_t button_debounce_ms[BTN_COUNT] = {
+    [BTN_UP] = KEY_DEBOUNCE_MS(btn_up),
+    [BTN_DOWN] = KEY_DEBOUNCE_MS(btn_down),
+    [BTN_LEFT] = KEY_DEBOUNCE_MS(btn_left),
+    [BTN_RIGHT] = KEY_DEBOUNCE_MS(btn_right),
+    [BTN_SELECT] = KEY_DEBOUNCE_MS(btn_select),
+    [BTN_BACK] = KEY_DEBOUNCE_MS(btn_back),
+};
+
+static void input_cb(struct input_event *evt, void *user_data) {
+  if (evt->type != INPUT_EV_KEY)
+    return;
+
+  for (int i = 0; i < BTN_COUNT; i++) {
+    if (button_codes[i] == evt->code) {
+      buttons_report_edge(i, evt->value,
+                          k_cycle_get_64() -
+                              k_ms_to_cyc_ceil64(button_debounce_ms[i]));
+      return;
+    }
+  }
+}
+INPUT_CALLBACK_DEFINE(NULL, input_cb, NULL);
+#endif
+
+void buttons_inject(Button btn, bool pressed, int64_t uptime_ms) {
+  queue_edge(btn, pressed, uptime_ms, k_cycle_get_64());
+}
+
+void buttons_set_live(bool live) {
+  atomic_set(&live_muted, !live);
+  atomic_clear(&held_mask); // Levels from the other source are stale
+}
+
+/* Starts or ends the gestures of a queued edge, fills in evt->held */
+static void track_edge(ButtonEvent *evt) {
+  Gesture *g = &gestures[evt->button];
+
+  if (evt->action == BTN_RELEASED) {
+    down &= ~BIT(evt->button);
+    memset(g, 0, sizeof(*g));
+    evt->held = down;
+    return;
+  }
+
+  down |= BIT(evt->button);
+  evt->held = down;
+  g->repeat_at =
+      timing->repeat_delay_ms ? evt->uptime_ms + timing->repeat_delay_ms : 0;
+  g->gap_ms = MAX(timing->repeat_interval_ms, 1);
+  g->long_at =
+      timing->long_press_ms ? evt->uptime_ms + timing->long_press_ms : 0;
+
+  uint8_t chord = down & timing->chord_mask;
+  if (!(chord & BIT(evt->button)) || POPCOUNT(chord) < 2)
+    return;
+
+  // Chord members neither repeat nor long-press until released
+  for (int i = 0; i < BTN_COUNT; i++) {
+    if (chord & BIT(i)) {
+      gestures[i].repeat_at = 0;
+      gestures[i].long_at = 0;
+    }
+  }
+  chord_event = *evt;
+  chord_event.action = BTN_CHORD;
+  chord_ready = true;
+}
+
+/* Repeats and long presses that are due, one event per call */
+static bool next_timed_event(ButtonEvent *evt) {
+  int64_t now = app_uptime_get();
+  int64_t next_due = INT64_MAX;
+
+  for (int i = 0; i < BTN_COUNT; i++) {
+    Gesture *g = &gestures[i];
+
+    if (!g->repeat_at && !g->long_at)
+      continue;
+
+    if (!button_held(i)) {
+      // Release is still on its way through the queue
+      memset(g, 0, sizeof(*g));
+      continue;
+    }
+
+    if (g->long_at && g->long_at <= now) {
+      *evt = (ButtonEvent){.uptime_ms = g->long_at,
+                           .edge_cycles = k_cycle_get_64(),
+                           .button = i,
+                           .action = BTN_LONG_PRESS,
+                           .held = down};
+      g->long_at = 0;
+      return true;
+    }
+
+    if (g->repeat_at && g->repeat_at <= now) {
+      *evt = (ButtonEvent){.uptime_ms = g->repeat_at,
+                           .edge_cycles = k_cycle_get_64(),
+                           .button = i,
+                           .action = BTN_REPEAT,
+                           .held = down};
+
+      // Repeats missed during a long frame go out as one multi-step event
+      while (g->repeat_at <= now && evt->steps < UINT8_MAX) {
+        evt->steps++;
+        g->repeat_at += g->gap_ms;
+        g->gap_ms = MAX(g->gap_ms * (100 - timing->repeat_accel_pct) / 100,
+                        MAX(timing->repeat_min_ms, 1));
+      }
+      g->repeat_at = MAX(g->repeat_at, now + 1);
+      return true;
+    }
+
+    if (g->long_at)
+      next_due = MIN(next_due, g->long_at);
+    if (g->repeat_at)
+      next_due = MIN(next_due, g->repeat_at);
+  }
+
+  if (next_due != INT64_MAX)
+    request_update_at(next_due);
+  return false;
+}
+
+bool buttons_next_event(ButtonEvent *evt) {
+  if (chord_ready) {
+    *evt = chord_event;
+    chord_ready = false;
+    return true;
+  }
+
+  if (k_msgq_get(&button_msgq, evt, K_NO_WAIT) == 0) {
+    track_edge(evt);
+    input_log_record(evt);
+    return true;
+  }
+
+  if (atomic_get(&dropped)) {
+    LOG_WRN("Button queue overflow, %ld edges dropped",
+            (long)atomic_set(&dropped, 0));
+  }
+  return next_timed_event(evt);
+}
+
+void buttons_flush(void) {
+  k_msgq_purge(&button_msgq);
+  memset(gestures, 0, sizeof(gestures));
+  down = 0;
+  chord_ready = false;
+}
+
+void buttons_set_timing(const ButtonTiming *app_timing) {
+  timing = app_timing ? app_timing : &default_timing;
+}
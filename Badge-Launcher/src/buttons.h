@@ -0,0 +1,41 @@
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include "app_shared.h"
+
+/* Default gesture timings (ButtonTiming) for apps that set none */
+#define BUTTON_REPEAT_DELAY_MS 400
+#define BUTTON_REPEAT_INTERVAL_MS 150
+#define BUTTON_REPEAT_MIN_MS 40
+#define BUTTON_REPEAT_ACCEL_PCT 15
+#define BUTTON_LONG_PRESS_MS 700
+
+/*
+ * Pops the next button event: a pending chord, then queued edges, then any
+ * repeat or long press that is due. Returns false when there is nothing
+ * left, after arming the next gesture as a loop deadline. Launcher thread
+ * only.
+ */
+bool buttons_next_event(ButtonEvent *evt);
+
+/* Drops queued edges and pending gestures (app switch) */
+void buttons_flush(void);
+
+/* Gesture timings of the app in front, NULL for the defaults */
+void buttons_set_timing(const ButtonTiming *app_timing);
+
+/*
+ * A debounced hardware edge, first seen at edge_cycles (k_cycle_get_64()).
+ * ISR-safe. Comes from debounce.c, or from gpio-keys through the input
+ * subsystem when CONFIG_BADGE_BUTTON_DEBOUNCE is off.
+ */
+void buttons_report_edge(Button btn, bool pressed, uint64_t edge_cycles);
+
+/*
+ * Input replay: queue an edge as if reported at uptime_ms (app_uptime_get()
+ * time, the recorded one), and mute the hardware
+ */
+void buttons_inject(Button btn, bool pressed, int64_t uptime_ms);
+void buttons_set_live(bool live);
+
+#endif
@@ -0,0 +1,195 @@
+#include "debounce.h"
+#include "buttons.h"
+
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+typedef struct {
+  uint32_t presses;
+  uint32_t releases;
+  uint32_t bounce_edges;  // Edges beyond the one that changed the state
+  uint32_t glitches;      // Edge bursts that settled back where they started
+  uint32_t max_edges;     // Most edges in one burst
+  uint32_t max_bounce_us; // First to last edge of the longest burst
+} BounceStats;
+
+typedef struct {
+  struct gpio_dt_spec spec;
+  struct gpio_callback cb;
+  uint8_t integrator; // 0 = released ... DEBOUNCE_SAMPLES = pressed
+  uint8_t quiet;      // Samples since the last edge
+  bool pressed;       // Debounced level
+  bool start_level;   // Debounced level when the burst began
+  uint16_t edges;     // Edges in the current burst, 0 = settled
+  uint64_t first_edge;
+  uint64_t last_edge;
+  BounceStats stats;
+} DebouncedButton;
+
+static DebouncedButton buttons[BTN_COUNT] = {
+    [BTN_UP] = {.spec = GPIO_DT_SPEC_GET(DT_ALIAS(btn_up), gpios)},
+    [BTN_DOWN] = {.spec = GPIO_DT_SPEC_GET(DT_ALIAS(btn_down), gpios)},
+    [BTN_LEFT] = {.spec = GPIO_DT_SPEC_GET(DT_ALIAS(btn_left), gpios)},
+    [BTN_RIGHT] = {.spec = GPIO_DT_SPEC_GET(DT_ALIAS(btn_right), gpios)},
+    [BTN_SELECT] = {.spec = GPIO_DT_SPEC_GET(DT_ALIAS(btn_select), gpios)},
+    [BTN_BACK] = {.spec = GPIO_DT_SPEC_GET(DT_ALIAS(btn_back), gpios)},
+};
+
+/* GPIO and timer interrupts both touch the integrators */
+static struct k_spinlock lock;
+static bool sampling; // Re-sample timer running
+
+static void sample_timer_fn(struct k_timer *timer);
+K_TIMER_DEFINE(sample_timer, sample_timer_fn, NULL);
+
+/* Burst over: the line has been quiet and the integrator is saturated */
+static void settle(DebouncedButton *b) {
+  BounceStats *st = &b->stats;
+  bool changed = b->pressed != b->start_level;
+  uint32_t bounce_us = k_cyc_to_us_floor32(b->last_edge - b->first_edge);
+
+  if (changed)
+    st->bounce_edges += b->edges - 1;
+  else
+    st->glitches++;
+  st->max_edges = MAX(st->max_edges, b->edges);
+  st->max_bounce_us = MAX(st->max_bounce_us, bounce_us);
+  b->edges = 0;
+}
+
+/* One integrator step. Returns true while the line still needs sampling. */
+static bool sample(Button btn) {
+  DebouncedButton *b = &buttons[btn];
+  int raw = gpio_pin_get_dt(&b->spec);
+
+  if (raw > 0 && b->integrator < DEBOUNCE_SAMPLES)
+    b->integrator++;
+  else if (raw == 0 && b->integrator > 0)
+    b->integrator--;
+
+  if (b->integrator == DEBOUNCE_SAMPLES && !b->pressed) {
+    b->pressed = true;
+    b->stats.presses++;
+    buttons_report_edge(btn, true, b->first_edge);
+  } else if (b->integrator == 0 && b->pressed) {
+    b->pressed = false;
+    b->stats.releases++;
+    buttons_report_edge(btn, false, b->first_edge);
+  }
+
+  if (b->quiet < UINT8_MAX)
+    b->quiet++;
+
+  bool saturated = b->integrator == (b->pressed ? DEBOUNCE_SAMPLES : 0);
+  if (saturated && b->quiet >= DEBOUNCE_SAMPLES) {
+    if (b->edges)
+      settle(b);
+    return false;
+  }
+  return true;
+}
+
+static void sample_timer_fn(struct k_timer *timer) {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  bool busy = false;
+
+  for (int i = 0; i < BTN_COUNT; i++) {
+    if (buttons[i].edges)
+      busy |= sample(i);
+  }
+
+  if (!busy) {
+    k_timer_stop(&sample_timer);
+    sampling = false;
+  }
+  k_spin_unlock(&lock, key);
+}
+
+static void edge_isr(const struct device *port, struct gpio_callback *cb,
+                     uint32_t pins) {
+  DebouncedButton *b = CONTAINER_OF(cb, DebouncedButton, cb);
+  uint64_t now = k_cycle_get_64();
+  k_spinlock_key_t key = k_spin_lock(&lock);
+
+  if (b->edges == 0) {
+    b->first_edge = now;
+    b->start_level = b->pressed;
+  }
+  b->last_edge = now;
+  if (b->edges < UINT16_MAX)
+    b->edges++;
+  b->quiet = 0;
+
+  // Count the edge itself as the first sample, the timer does the rest
+  sample(b - buttons);
+  if (!sampling) {
+    k_timer_start(&sample_timer, K_USEC(DEBOUNCE_SAMPLE_US),
+                  K_USEC(DEBOUNCE_SAMPLE_US));
+    sampling = true;
+  }
+  k_spin_unlock(&lock, key);
+}
+
+int debounce_init(void) {
+  for (int i = 0; i < BTN_COUNT; i++) {
+    DebouncedButton *b = &buttons[i];
+    int rc;
+
+    if (!gpio_is_ready_dt(&b->spec)) {
+      LOG_ERR("Button %s: GPIO not ready", button_name(i));
+      return -ENODEV;
+    }
+
+    rc = gpio_pin_configure_dt(&b->spec, GPIO_INPUT);
+    if (rc == 0) {
+      b->pressed = gpio_pin_get_dt(&b->spec) > 0;
+      b->integrator = b->pressed ? DEBOUNCE_SAMPLES : 0;
+      b->quiet = DEBOUNCE_SAMPLES;
+
+      gpio_init_callback(&b->cb, edge_isr, BIT(b->spec.pin));
+      rc = gpio_add_callback_dt(&b->spec, &b->cb);
+    }
+    if (rc == 0)
+      rc = gpio_pin_interrupt_configure_dt(&b->spec, GPIO_INT_EDGE_BOTH);
+    if (rc < 0) {
+      LOG_ERR("Button %s: setup failed (%d)", button_name(i), rc);
+      return rc;
+    }
+  }
+  return 0;
+}
+
+/* Shell: badge bounce [reset] */
+static int cmd_bounce(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Usage: badge bounce [reset]");
+      return -EINVAL;
+    }
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    for (int i = 0; i < BTN_COUNT; i++)
+      memset(&buttons[i].stats, 0, sizeof(buttons[i].stats));
+    k_spin_unlock(&lock, key);
+    shell_print(sh, "Bounce stats cleared");
+    return 0;
+  }
+
+  shell_print(sh, "Integrator: %d samples every %d us", DEBOUNCE_SAMPLES,
+              DEBOUNCE_SAMPLE_US);
+  shell_print(sh, "  %-7s %8s %8s %8s %8s %9s %10s", "button", "presses",
+              "releases", "bounces", "glitches", "max edges", "max bounce");
+  for (int i = 0; i < BTN_COUNT; i++) {
+    const BounceStats *st = &buttons[i].stats;
+
+    shell_print(sh, "  %-7s %8u %8u %8u %8u %9u %7u us", button_name(i),
+                st->presses, st->releases, st->bounce_edges, st->glitches,
+                st->max_edges, st->max_bounce_us);
+  }
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), bounce, NULL,
+                 "Per-button debounce stats\nUsage: badge bounce [reset]",
+                 cmd_bounce, 1, 1);
@@ -0,0 +1,20 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include "app_shared.h"
+
+/*
+ * Button debouncer (CONFIG_BADGE_BUTTON_DEBOUNCE). The first edge on a
+ * button line interrupts, then a kernel timer re-samples every
+ * DEBOUNCE_SAMPLE_US into a saturating integrator. A press or release is
+ * reported once DEBOUNCE_SAMPLES consecutive samples agree, stamped with the
+ * time of its first edge, and the timer stops once every line is quiet.
+ * Per-button bounce stats: "badge bounce".
+ */
+#define DEBOUNCE_SAMPLE_US 1000
+#define DEBOUNCE_SAMPLES 4
+
+/* Configures the button lines and their interrupts */
+int debounce_init(void);
+
+#endif
@@ -29,12 +29,7 @@ static int32_t display_width;
 static int32_t display_height;
 static int32_t img_width;
 static int32_t img_height;
-static int64_t last_tick;
 
-// Input State
-static int btn_left_prev = 0;
-static int btn_right_prev = 0;
-static int btn_up_prev = 0;
 static int current_speed = 10;
 
 static void update_sprite_dimensions(void) {
@@ -54,15 +49,14 @@ static void update_sprite_dimensions(void) {
   }
 }
 
-static void dvd_enter(void) {
-  lv_obj_clean(lv_scr_act());
-  lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+static void dvd_enter(lv_obj_t *scr) {
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
 
   display_width = lv_disp_get_hor_res(NULL);
   display_height = lv_disp_get_ver_res(NULL);
 
-  img = lv_img_create(lv_scr_act());
+  img = lv_img_create(scr);
   // Start with default
   update_sprite_dimensions();
 
@@ -79,21 +73,15 @@ static void dvd_enter(void) {
 
   dx = 10;
   dy = 10;
-
-  last_tick = k_uptime_get();
-
-  // Reset input state
-  btn_left_prev = gpio_pin_get_dt(&btn_left);
-  btn_right_prev = gpio_pin_get_dt(&btn_right);
 }
 
-static void dvd_update(void) {
-  // Input Handling (Run every cycle for responsiveness)
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right);
+static void dvd_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
+
   bool sprite_changed = false;
 
-  if (btn_left_curr && !btn_left_prev) {
+  if (evt->button == BTN_LEFT) {
     current_sprite_index--;
     if (current_sprite_index < 0)
       current_sprite_index = NUM_SPRITES - 1;
@@ -101,7 +89,7 @@ static void dvd_update(void) {
     play_beep_move();
   }
 
-  if (btn_right_curr && !btn_right_prev) {
+  if (evt->button == BTN_RIGHT) {
     current_sprite_index++;
     if (current_sprite_index >= NUM_SPRITES)
       current_sprite_index = 0;
@@ -109,69 +97,55 @@ static void dvd_update(void) {
     play_beep_move();
   }
 
-  btn_left_prev = btn_left_curr;
-  btn_right_prev = btn_right_curr;
-
-  if (sprite_changed) {
+  if (sprite_changed)
     update_sprite_dimensions();
-    lv_obj_invalidate(lv_scr_act()); // Force redraw immediately
-  }
-
-  // Animation Logic (Throttled)
-  // Animation Logic (Throttled)
-  int64_t now = k_uptime_get();
-  if (now - last_tick > 500) {
-
-    // Speed Control (UP Button) - Increment permanent speed
-    int btn_up_curr = gpio_pin_get_dt(&btn_up);
-    if (btn_up_curr && !btn_up_prev) {
-      current_speed += 10;
-      if (current_speed > 50)
-        current_speed = 10; // Cycle 10-50
-      play_beep_move();     // Audio feedback
-    }
-    btn_up_prev = btn_up_curr;
 
-    // Preserve direction but apply new speed magnitude
-    dx = (dx > 0) ? current_speed : -current_speed;
-    dy = (dy > 0) ? current_speed : -current_speed;
+  // Speed Control (UP Button) - Increment permanent speed
+  if (evt->button == BTN_UP) {
+    current_speed += 10;
+    if (current_speed > 50)
+      current_speed = 10; // Cycle 10-50
+    play_beep_move();     // Audio feedback
+  }
+}
 
-    lv_obj_set_pos(img, x, y);
+// Animation Logic (500ms tick, slow enough for the e-ink panel)
+static void dvd_tick(void) {
+  // Preserve direction but apply new speed magnitude
+  dx = (dx > 0) ? current_speed : -current_speed;
+  dy = (dy > 0) ? current_speed : -current_speed;
 
-    /* Force Full Redraw for E-Ink artifact cleaning */
-    lv_obj_invalidate(lv_scr_act());
+  // Only the old and new sprite areas redraw, the refresh manager cleans up
+  lv_obj_set_pos(img, x, y);
 
-    last_tick = now;
+  /* Update Position */
+  x += dx;
+  y += dy;
 
-    /* Update Position */
-    x += dx;
-    y += dy;
+  /* Bounce Logic */
+  const SpriteInfo *info = &sprites[current_sprite_index];
+  int offset_top = info->offset_top;
+  int offset_bottom = info->offset_bottom;
+
+  // Horizontal Bounce (Standard)
+  if (x <= 0) {
+    x = 0;
+    dx = -dx;
+  } else if (x + img_width >= display_width) {
+    x = display_width - img_width;
+    dx = -dx;
+  }
 
-    /* Bounce Logic */
-    const SpriteInfo *info = &sprites[current_sprite_index];
-    int offset_top = info->offset_top;
-    int offset_bottom = info->offset_bottom;
-
-    // Horizontal Bounce (Standard)
-    if (x <= 0) {
-      x = 0;
-      dx = -dx;
-    } else if (x + img_width >= display_width) {
-      x = display_width - img_width;
-      dx = -dx;
-    }
-
-    // Vertical Bounce (with Offsets)
-    // Top collision: visual top is (y + offset_top)
-    if (y + offset_top <= 0) {
-      y = -offset_top; // Snap so visual top is at 0
-      dy = -dy;
-    }
-    // Bottom collision: visual bottom is (y + img_height - offset_bottom)
-    else if (y + img_height - offset_bottom >= display_height) {
-      y = display_height - (img_height - offset_bottom); // Snap
-      dy = -dy;
-    }
+  // Vertical Bounce (with Offsets)
+  // Top collision: visual top is (y + offset_top)
+  if (y + offset_top <= 0) {
+    y = -offset_top; // Snap so visual top is at 0
+    dy = -dy;
+  }
+  // Bottom collision: visual bottom is (y + img_height - offset_bottom)
+  else if (y + img_height - offset_bottom >= display_height) {
+    y = display_height - (img_height - offset_bottom); // Snap
+    dy = -dy;
   }
 }
 
@@ -181,5 +155,8 @@ static void dvd_exit(void) {
 
 App dvd_app = {.name = "DVD Screensaver",
                .enter = dvd_enter,
-               .update = dvd_update,
-               .exit = dvd_exit};
+               .input = dvd_input,
+               .exit = dvd_exit,
+               .tick_ms = 500,
+               .tick = dvd_tick,
+               .refresh = REFRESH_FAST};
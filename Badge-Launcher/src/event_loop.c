@@ -0,0 +1,181 @@
+#include "event_loop.h"
+#include "app_shared.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+K_EVENT_DEFINE(loop_event);
+
+/* Earliest uptime (ms) at which the current app wants update() called */
+static int64_t app_deadline = INT64_MAX;
+
+/* Forced fixed wake interval for A/B comparisons (0 = event-driven) */
+static atomic_t poll_override_ms;
+
+/* Fixed-Timestep Ticks */
+#define MAX_CATCHUP_TICKS 4 // Beyond this, drop ticks instead of spiralling
+
+static int64_t next_tick_at;
+static uint32_t ticks_run;
+static uint32_t ticks_late;    // Ran behind schedule (caught up)
+static uint32_t ticks_dropped; // Skipped after a stall
+static int64_t max_tick_lateness;
+
+/* Wakeup Counter */
+static atomic_t wakeups;
+static atomic_val_t wakeups_snapshot;
+static int64_t snapshot_time;
+
+void request_update_at(int64_t uptime_ms) {
+  if (uptime_ms < app_deadline)
+    app_deadline = uptime_ms;
+}
+
+void request_update_in(uint32_t delay_ms) {
+  request_update_at(app_uptime_get() + delay_ms);
+}
+
+void wake_launcher(void) { k_event_post(&loop_event, LOOP_EVT_WAKE); }
+
+void event_loop_post_input(void) { k_event_post(&loop_event, LOOP_EVT_INPUT); }
+
+uint32_t event_loop_wait(uint32_t lv_next_ms) {
+  int64_t now = k_uptime_get();
+  int64_t wake_at = app_deadline;
+
+  if (lv_next_ms != LV_NO_TIMER_READY)
+    wake_at = MIN(wake_at, now + lv_next_ms);
+
+  int poll_ms = atomic_get(&poll_override_ms);
+  if (poll_ms > 0)
+    wake_at = MIN(wake_at, now + poll_ms);
+
+  k_timeout_t timeout = K_FOREVER;
+  if (wake_at != INT64_MAX)
+    timeout = K_MSEC(MAX(wake_at - now, 0));
+
+  uint32_t events = k_event_wait(&loop_event, LOOP_EVT_ALL, false, timeout);
+  k_event_clear(&loop_event, events);
+
+  // Apps re-arm their deadline from update() every time they run
+  app_deadline = INT64_MAX;
+  atomic_inc(&wakeups);
+
+  return events;
+}
+
+int64_t event_loop_take_deadline(void) {
+  int64_t deadline = app_deadline;
+
+  app_deadline = INT64_MAX;
+  atomic_inc(&wakeups);
+  return deadline;
+}
+
+void event_loop_start_ticks(const App *app) {
+  if (!app->tick || app->tick_ms == 0)
+    return;
+
+  next_tick_at = app_uptime_get() + app->tick_ms;
+  request_update_at(next_tick_at);
+}
+
+void event_loop_run_ticks(const App *app) {
+  if (!app->tick || app->tick_ms == 0)
+    return;
+
+  int64_t now = app_uptime_get();
+  int ran = 0;
+
+  while (now >= next_tick_at) {
+    if (ran == MAX_CATCHUP_TICKS) {
+      // Stalled (blocking call, long render): resync instead of bursting
+      int64_t missed = (now - next_tick_at) / app->tick_ms + 1;
+      ticks_dropped += missed;
+      next_tick_at += missed * app->tick_ms;
+      break;
+    }
+
+    int64_t lateness = now - next_tick_at;
+    if (lateness >= app->tick_ms)
+      ticks_late++;
+    if (lateness > max_tick_lateness)
+      max_tick_lateness = lateness;
+
+    app->tick();
+    ticks_run++;
+    ran++;
+
+    // Advance by the period, not from "now", so the rate never drifts
+    next_tick_at += app->tick_ms;
+  }
+
+  request_update_at(next_tick_at);
+}
+
+/* Shell: badge wakeups / badge poll / badge ticks */
+static int cmd_wakeups(const struct shell *sh, size_t argc, char **argv) {
+  int64_t now = k_uptime_get();
+  atomic_val_t total = atomic_get(&wakeups);
+  int64_t elapsed = now - snapshot_time;
+  atomic_val_t delta = total - wakeups_snapshot;
+
+  shell_print(sh, "Total wakeups: %ld", (long)total);
+  if (elapsed > 0) {
+    int64_t milli_rate = (int64_t)delta * 1000000 / elapsed;
+    shell_print(sh, "Since last query: %ld in %lld ms (%lld.%03lld /s)",
+                (long)delta, (long long)elapsed, (long long)milli_rate / 1000,
+                (long long)milli_rate % 1000);
+  }
+  shell_print(sh, "Mode: %s",
+              atomic_get(&poll_override_ms) ? "fixed poll" : "event-driven");
+
+  wakeups_snapshot = total;
+  snapshot_time = now;
+  return 0;
+}
+
+static int cmd_poll(const struct shell *sh, size_t argc, char **argv) {
+  int ms = atoi(argv[1]);
+
+  if (ms < 0) {
+    shell_error(sh, "Interval must be >= 0");
+    return -EINVAL;
+  }
+  atomic_set(&poll_override_ms, ms);
+  wake_launcher();
+  if (ms)
+    shell_print(sh, "Polling every %d ms", ms);
+  else
+    shell_print(sh, "Event-driven");
+  return 0;
+}
+
+static int cmd_ticks(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+    ticks_run = 0;
+    ticks_late = 0;
+    ticks_dropped = 0;
+    max_tick_lateness = 0;
+    return 0;
+  }
+
+  shell_print(sh, "Ticks: %u run, %u caught up, %u dropped", ticks_run,
+              ticks_late, ticks_dropped);
+  shell_print(sh, "Max lateness: %lld ms", (long long)max_tick_lateness);
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), wakeups, NULL,
+                 "Main loop wakeups (rate since the previous query)",
+                 cmd_wakeups, 1, 0);
+SHELL_SUBCMD_ADD((badge), poll, NULL,
+                 "Force a fixed wake interval in ms (0 = event-driven)\n"
+                 "Usage: badge poll <ms>",
+                 cmd_poll, 2, 0);
+SHELL_SUBCMD_ADD((badge), ticks, NULL,
+                 "App tick scheduling stats\nUsage: badge ticks [reset]",
+                 cmd_ticks, 1, 1);
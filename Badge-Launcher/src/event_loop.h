@@ -0,0 +1,36 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include "app_shared.h"
+#include <zephyr/kernel.h>
+
+/* Wake Reasons (bitmask returned by event_loop_wait) */
+#define LOOP_EVT_INPUT BIT(0) // Button event queued
+#define LOOP_EVT_WAKE BIT(1)  // Explicit wake (UART RX, etc.)
+#define LOOP_EVT_ALL (LOOP_EVT_INPUT | LOOP_EVT_WAKE)
+
+/* Wakes the loop for a queued button event (any context) */
+void event_loop_post_input(void);
+
+/*
+ * Sleeps until a button edge, an explicit wake, LVGL's next timer
+ * (lv_next_ms, the return value of lv_task_handler) or the earliest app
+ * deadline. Returns the LOOP_EVT_* bits that caused the wake (0 = timeout).
+ */
+uint32_t event_loop_wait(uint32_t lv_next_ms);
+
+/*
+ * Wakes without sleeping (input replay, which runs on a virtual clock):
+ * returns the earliest app deadline and clears it like event_loop_wait().
+ */
+int64_t event_loop_take_deadline(void);
+
+/*
+ * Fixed-timestep ticking of the foreground app. start resets the schedule
+ * (call after enter), run catches up on every tick that is due and arms the
+ * next tick as the app deadline.
+ */
+void event_loop_start_ticks(const App *app);
+void event_loop_run_ticks(const App *app);
+
+#endif
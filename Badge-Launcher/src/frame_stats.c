@@ -0,0 +1,461 @@
+#include "frame_stats.h"
+#include "buttons.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+/* Histogram: bucket i holds samples in [2^i, 2^(i+1)) us, last is open */
+#define HIST_BUCKETS 22 // Up to ~2s, e-ink full refreshes land near the top
+#define MAX_TRACKED_APPS 24
+
+#define LATENCY_WINDOW 128      // Most recent presses kept per app
+#define LATENCY_TIMEOUT_MS 2000 // No refresh by then: the press went unseen
+
+typedef struct {
+  uint32_t buckets[HIST_BUCKETS];
+  uint32_t count;
+  uint64_t total_us;
+  uint32_t max_us;
+} Histogram;
+
+typedef enum {
+  PHASE_UPDATE,
+  PHASE_RENDER,
+  PHASE_FLUSH,
+  PHASE_BUILD,
+  PHASE_LAUNCH,
+  NUM_PHASES
+} Phase;
+
+static const char *const phase_names[NUM_PHASES] = {
+    "update", "render", "flush", "build", "launch"};
+
+typedef struct {
+  uint32_t us;
+  uint8_t button;
+} LatencySample;
+
+typedef struct {
+  const App *app;
+  Histogram hist[NUM_PHASES];
+  uint32_t frames; // Refreshes that flushed at least once
+  uint32_t invalidated_areas;
+  uint64_t flushed_pixels;
+  LatencySample latency[LATENCY_WINDOW]; // Ring, press to flush finished
+  uint32_t presses;                      // Samples ever taken (ring head)
+  uint32_t unanswered;                   // Presses that never hit the panel
+} AppStats;
+
+static AppStats stats[MAX_TRACKED_APPS];
+static int num_stats;
+static AppStats *current; // NULL once the table is full
+
+/* In-flight measurements (main thread only) */
+static uint64_t update_start;
+static uint64_t render_start;
+static uint64_t flush_start;
+static uint64_t flush_cycles;          // Flush time inside the current render
+static uint64_t flush_done;            // End of the last flush
+static uint32_t last_flush_us;         // Length of the last flush
+static uint64_t press_edge[BTN_COUNT]; // Unanswered press, 0 = none
+static uint64_t build_start;
+static uint64_t launch_start;
+static bool launch_shown; // Screen loaded, waiting for its first flush
+
+/* Reset is requested from the shell thread, applied by the main thread */
+static atomic_t reset_pending;
+
+static void hist_add(Histogram *h, uint64_t cycles) {
+  uint32_t us = (uint32_t)MIN(k_cyc_to_us_floor64(cycles), UINT32_MAX);
+  int bucket = 0;
+
+  while (bucket < HIST_BUCKETS - 1 && (us >> (bucket + 1)) != 0)
+    bucket++;
+
+  h->buckets[bucket]++;
+  h->count++;
+  h->total_us += us;
+  if (us > h->max_us)
+    h->max_us = us;
+}
+
+/* Upper bound (us) of the bucket holding the pct-th percentile sample */
+static uint32_t hist_percentile(const Histogram *h, int pct) {
+  uint32_t target = (h->count * pct + 99) / 100;
+  uint32_t seen = 0;
+
+  for (int i = 0; i < HIST_BUCKETS; i++) {
+    seen += h->buckets[i];
+    if (seen >= target && seen > 0)
+      return (i == HIST_BUCKETS - 1) ? h->max_us : MIN(BIT(i + 1), h->max_us);
+  }
+  return 0;
+}
+
+static void drop_pending_presses(void) {
+  memset(press_edge, 0, sizeof(press_edge));
+}
+
+static void apply_pending_reset(void) {
+  if (!atomic_cas(&reset_pending, 1, 0))
+    return;
+
+  for (int i = 0; i < num_stats; i++) {
+    const App *app = stats[i].app;
+    memset(&stats[i], 0, sizeof(stats[i]));
+    stats[i].app = app;
+  }
+}
+
+static void display_event_cb(lv_event_t *e) {
+  if (!current)
+    return;
+
+  const lv_area_t *area = lv_event_get_param(e);
+
+  switch (lv_event_get_code(e)) {
+  case LV_EVENT_INVALIDATE_AREA:
+    current->invalidated_areas++;
+    break;
+  case LV_EVENT_FLUSH_START:
+    flush_start = k_cycle_get_64();
+    break;
+  case LV_EVENT_FLUSH_FINISH:
+    flush_done = k_cycle_get_64();
+    flush_cycles += flush_done - flush_start;
+    last_flush_us = k_cyc_to_us_near32(flush_done - flush_start);
+    if (area)
+      current->flushed_pixels += (uint64_t)lv_area_get_width(area) *
+                                 lv_area_get_height(area);
+    break;
+  default:
+    break;
+  }
+}
+
+uint32_t frame_stats_last_flush_us(void) { return last_flush_us; }
+
+void frame_stats_init(void) {
+  lv_display_t *disp = lv_display_get_default();
+
+  if (!disp) {
+    LOG_ERR("No display, flush stats disabled");
+    return;
+  }
+  lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_INVALIDATE_AREA,
+                          NULL);
+  lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_START, NULL);
+  lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_FINISH, NULL);
+}
+
+void frame_stats_set_app(const App *app) {
+  apply_pending_reset();
+  drop_pending_presses(); // A switch is measured as launch instead
+
+  for (int i = 0; i < num_stats; i++) {
+    if (stats[i].app == app) {
+      current = &stats[i];
+      return;
+    }
+  }
+
+  if (num_stats == MAX_TRACKED_APPS) {
+    LOG_WRN("Frame stats table full, not tracking %s", app->name);
+    current = NULL;
+    return;
+  }
+
+  current = &stats[num_stats++];
+  current->app = app;
+}
+
+void frame_stats_update_begin(void) {
+  apply_pending_reset();
+  update_start = k_cycle_get_64();
+}
+
+void frame_stats_update_end(void) {
+  if (current)
+    hist_add(&current->hist[PHASE_UPDATE], k_cycle_get_64() - update_start);
+}
+
+void frame_stats_input(const ButtonEvent *evt) {
+  // Only the first press per button is timed until a refresh answers it
+  if (evt->action == BTN_PRESSED && evt->button < BTN_COUNT &&
+      !press_edge[evt->button])
+    press_edge[evt->button] = evt->edge_cycles;
+}
+
+static void answer_presses(void) {
+  for (int i = 0; i < BTN_COUNT; i++) {
+    if (!press_edge[i])
+      continue;
+
+    uint64_t us = k_cyc_to_us_floor64(flush_done - press_edge[i]);
+    LatencySample *sample =
+        &current->latency[current->presses % LATENCY_WINDOW];
+
+    sample->us = (uint32_t)MIN(us, UINT32_MAX);
+    sample->button = i;
+    current->presses++;
+    press_edge[i] = 0;
+  }
+}
+
+static void expire_presses(void) {
+  uint64_t now = k_cycle_get_64();
+
+  for (int i = 0; i < BTN_COUNT; i++) {
+    if (press_edge[i] &&
+        now - press_edge[i] > k_ms_to_cyc_ceil64(LATENCY_TIMEOUT_MS)) {
+      current->unanswered++;
+      press_edge[i] = 0;
+    }
+  }
+}
+
+void frame_stats_render_begin(void) {
+  flush_cycles = 0;
+  render_start = k_cycle_get_64();
+}
+
+void frame_stats_render_end(void) {
+  uint64_t total = k_cycle_get_64() - render_start;
+
+  if (!current)
+    return;
+
+  hist_add(&current->hist[PHASE_RENDER], total - MIN(flush_cycles, total));
+  if (flush_cycles) {
+    hist_add(&current->hist[PHASE_FLUSH], flush_cycles);
+    current->frames++;
+    answer_presses();
+
+    if (launch_shown) {
+      hist_add(&current->hist[PHASE_LAUNCH], k_cycle_get_64() - launch_start);
+      launch_shown = false;
+    }
+  } else {
+    expire_presses();
+  }
+}
+
+void frame_stats_build_begin(void) { build_start = k_cycle_get_64(); }
+
+void frame_stats_build_end(void) {
+  if (current)
+    hist_add(&current->hist[PHASE_BUILD], k_cycle_get_64() - build_start);
+}
+
+void frame_stats_launch_begin(void) {
+  launch_start = k_cycle_get_64();
+  launch_shown = false;
+}
+
+void frame_stats_launch_shown(void) { launch_shown = true; }
+
+/* Shell: badge stats [app|reset] */
+static void print_summary_row(const struct shell *sh, const char *label,
+                              const Histogram *h) {
+  if (h->count == 0) {
+    shell_print(sh, "  %-7s -", label);
+    return;
+  }
+  shell_print(sh, "  %-7s n=%-6u avg=%-7u p50<=%-7u p99<=%-7u max=%u", label,
+              h->count, (uint32_t)(h->total_us / h->count),
+              hist_percentile(h, 50), hist_percentile(h, 99), h->max_us);
+}
+
+static void print_app_summary(const struct shell *sh, const AppStats *s) {
+  shell_print(sh, "%s: %u frames, %u invalidated areas, %llu px flushed",
+              s->app->name, s->frames, s->invalidated_areas,
+              (unsigned long long)s->flushed_pixels);
+  for (int p = 0; p < NUM_PHASES; p++)
+    print_summary_row(sh, phase_names[p], &s->hist[p]);
+}
+
+static void print_histogram(const struct shell *sh, const char *label,
+                            const Histogram *h) {
+  uint32_t peak = 0;
+
+  for (int i = 0; i < HIST_BUCKETS; i++)
+    peak = MAX(peak, h->buckets[i]);
+  if (peak == 0)
+    return;
+
+  shell_print(sh, "%s (us):", label);
+  for (int i = 0; i < HIST_BUCKETS; i++) {
+    char bar[33];
+    int len = h->buckets[i] * (sizeof(bar) - 1) / peak;
+
+    if (h->buckets[i] == 0)
+      continue;
+    if (len == 0)
+      len = 1;
+    memset(bar, '#', len);
+    bar[len] = '\0';
+
+    if (i == HIST_BUCKETS - 1)
+      shell_print(sh, "  >=%-8lu %6u %s", BIT(i), h->buckets[i], bar);
+    else
+      shell_print(sh, "  <%-9lu %6u %s", BIT(i + 1), h->buckets[i], bar);
+  }
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+    atomic_set(&reset_pending, 1);
+    wake_launcher();
+    shell_print(sh, "Stats cleared");
+    return 0;
+  }
+
+  if (argc == 1) {
+    if (num_stats == 0)
+      shell_print(sh, "No samples yet");
+    for (int i = 0; i < num_stats; i++)
+      print_app_summary(sh, &stats[i]);
+    return 0;
+  }
+
+  // Case-insensitive prefix match so "badge stats dvd" works
+  for (int i = 0; i < num_stats; i++) {
+    if (strncasecmp(stats[i].app->name, argv[1], strlen(argv[1])) != 0)
+      continue;
+
+    print_app_summary(sh, &stats[i]);
+    for (int p = 0; p < NUM_PHASES; p++)
+      print_histogram(sh, phase_names[p], &stats[i].hist[p]);
+    return 0;
+  }
+
+  shell_error(sh, "No stats for app '%s'", argv[1]);
+  return -ENOENT;
+}
+
+SHELL_SUBCMD_ADD((badge), stats, NULL,
+                 "Per-app update/render/flush/build/launch times (us)\n"
+                 "Usage: badge stats [app|reset]",
+                 cmd_stats, 1, 1);
+
+/* Shell: badge latency [app|reset|dump] */
+typedef struct {
+  uint32_t n;
+  uint32_t p50, p95, p99, max;
+} LatencySummary;
+
+static int cmp_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentiles over the retained window; button < 0 is all */
+static LatencySummary summarize_latency(const AppStats *s, int button) {
+  static uint32_t sorted[LATENCY_WINDOW]; // Shell thread only
+  LatencySummary sum = {0};
+  uint32_t kept = MIN(s->presses, LATENCY_WINDOW);
+
+  for (uint32_t i = 0; i < kept; i++) {
+    if (button < 0 || s->latency[i].button == button)
+      sorted[sum.n++] = s->latency[i].us;
+  }
+  if (sum.n == 0)
+    return sum;
+
+  qsort(sorted, sum.n, sizeof(sorted[0]), cmp_u32);
+  sum.p50 = sorted[(sum.n * 50 + 99) / 100 - 1];
+  sum.p95 = sorted[(sum.n * 95 + 99) / 100 - 1];
+  sum.p99 = sorted[(sum.n * 99 + 99) / 100 - 1];
+  sum.max = sorted[sum.n - 1];
+  return sum;
+}
+
+static void print_latency_row(const struct shell *sh, const char *label,
+                              const LatencySummary *sum) {
+  shell_print(sh, "  %-7s n=%-4u p50=%-7u p95=%-7u p99=%-7u max=%u", label,
+              sum->n, sum->p50, sum->p95, sum->p99, sum->max);
+}
+
+static void print_app_latency(const struct shell *sh, const AppStats *s) {
+  LatencySummary all = summarize_latency(s, -1);
+
+  shell_print(sh, "%s: %u presses (last %u kept), %u unanswered (us)",
+              s->app->name, s->presses, all.n, s->unanswered);
+  if (all.n == 0)
+    return;
+
+  print_latency_row(sh, "all", &all);
+  for (int b = 0; b < BTN_COUNT; b++) {
+    LatencySummary sum = summarize_latency(s, b);
+
+    if (sum.n)
+      print_latency_row(sh, button_name(b), &sum);
+  }
+}
+
+/* One CSV row per app and button (plus "all") for scripts */
+static void dump_latency(const struct shell *sh) {
+  shell_print(sh, "app,button,presses,unanswered,n,p50_us,p95_us,p99_us,"
+                  "max_us");
+  for (int i = 0; i < num_stats; i++) {
+    const AppStats *s = &stats[i];
+
+    for (int b = -1; b < BTN_COUNT; b++) {
+      LatencySummary sum = summarize_latency(s, b);
+
+      if (sum.n == 0)
+        continue;
+      shell_print(sh, "%s,%s,%u,%u,%u,%u,%u,%u,%u", s->app->name,
+                  b < 0 ? "all" : button_name(b), s->presses, s->unanswered,
+                  sum.n, sum.p50, sum.p95, sum.p99, sum.max);
+    }
+  }
+}
+
+static int cmd_latency(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+    atomic_set(&reset_pending, 1);
+    wake_launcher();
+    shell_print(sh, "Stats cleared");
+    return 0;
+  }
+
+  if (argc > 1 && strcmp(argv[1], "dump") == 0) {
+    dump_latency(sh);
+    return 0;
+  }
+
+  bool found = false;
+  for (int i = 0; i < num_stats; i++) {
+    if (argc > 1 &&
+        strncasecmp(stats[i].app->name, argv[1], strlen(argv[1])) != 0)
+      continue;
+    if (argc == 1 && stats[i].presses == 0 && stats[i].unanswered == 0)
+      continue;
+
+    print_app_latency(sh, &stats[i]);
+    found = true;
+    if (argc > 1)
+      break;
+  }
+
+  if (!found) {
+    if (argc > 1) {
+      shell_error(sh, "No stats for app '%s'", argv[1]);
+      return -ENOENT;
+    }
+    shell_print(sh, "No presses yet");
+  }
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), latency, NULL,
+                 "Press-to-photon latency per app and button (us)\n"
+                 "Usage: badge latency [app|reset|dump]",
+                 cmd_latency, 1, 1);
@@ -0,0 +1,43 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include "app_shared.h"
+
+/*
+ * Per-app frame cost accounting, read back with "badge stats [app]".
+ * Update covers App.update() plus its ticks, render is lv_task_handler()
+ * minus the time spent inside the display flush, flush is the blocking
+ * display write for one refresh. Build is App.enter() on the off-screen
+ * screen, launch runs from the switch request to the first flush of the
+ * app's screen.
+ *
+ * Press-to-photon latency ("badge latency") runs from a button's GPIO edge
+ * to the end of the first flush after the app has handled the press.
+ */
+
+/* Hooks the default display's invalidate/flush events. Call once LVGL is up. */
+void frame_stats_init(void);
+
+/* Attributes everything measured from now on to app */
+void frame_stats_set_app(const App *app);
+
+void frame_stats_update_begin(void);
+void frame_stats_update_end(void);
+
+void frame_stats_render_begin(void);
+void frame_stats_render_end(void);
+
+void frame_stats_build_begin(void);
+void frame_stats_build_end(void);
+
+/* How long the panel took over its last refresh, for pacing animations */
+uint32_t frame_stats_last_flush_us(void);
+
+/* Feed every button event before it is dispatched to the app */
+void frame_stats_input(const ButtonEvent *evt);
+
+/* Launch latency: begin on the switch request, shown when the screen loads */
+void frame_stats_launch_begin(void);
+void frame_stats_launch_shown(void);
+
+#endif
@@ -1,5 +1,6 @@
 #include "froggr.h"
-#include <zephyr/random/random.h>
+#include "audio.h"
+#include "tile_map.h"
 
 LOG_MODULE_REGISTER(froggr, LOG_LEVEL_INF);
 
@@ -7,6 +8,7 @@ LOG_MODULE_REGISTER(froggr, LOG_LEVEL_INF);
 #define COLS 20
 #define ROWS 15
 #define CELL_SIZE 20
+#define TICK_MS 50
 
 // Lane Types
 #define LANE_SAFE 0
@@ -14,6 +16,44 @@ LOG_MODULE_REGISTER(froggr, LOG_LEVEL_INF);
 #define LANE_RIVER 2
 #define LANE_GOAL 3
 
+// Sounds
+static const SfxDef sfx_hop = {.name = "hop",
+                               .start_hz = 600,
+                               .end_hz = 1000,
+                               .duration_ms = 20,
+                               .duty = 25};
+
+static const SfxDef sfx_squash = {.name = "squash",
+                                  .start_hz = 400,
+                                  .end_hz = 60,
+                                  .duration_ms = 250,
+                                  .curve = SFX_LINEAR_PERIOD,
+                                  .duty = 12,
+                                  .decay_ms = 150,
+                                  .priority = 2};
+
+static const SfxDef sfx_splash = {.name = "splash",
+                                  .start_hz = 1200,
+                                  .end_hz = 200,
+                                  .duration_ms = 300,
+                                  .volume = 10,
+                                  .attack_ms = 20,
+                                  .decay_ms = 200,
+                                  .priority = 2,
+                                  .arp_ms = 5,
+                                  .arp_steps = 4,
+                                  .arp = {0, 7, -3, 5}};
+
+static const SfxDef sfx_win = {.name = "win",
+                               .start_hz = 523,
+                               .end_hz = 523,
+                               .duration_ms = 480,
+                               .decay_ms = 120,
+                               .priority = 2,
+                               .arp_ms = 120,
+                               .arp_steps = 4,
+                               .arp = {0, 4, 7, 12}};
+
 // Entity (Obstacle/Log)
 typedef struct {
   int x;
@@ -24,9 +64,9 @@ typedef struct {
 // Lane Config
 typedef struct {
   int type;
-  int speed;     // Tick interval (lower = faster)
+  int speed;     // Move interval in ms (lower = faster)
   int direction; // 1 = Right, -1 = Left
-  int64_t last_move;
+  int timer;     // ms accumulated towards the next move
   Obstacle obstacles[5]; // Max obstacles per lane
   int obstacle_count;
 } Lane;
@@ -42,7 +82,20 @@ static bool win_state;
 static lv_obj_t *main_cont;
 static lv_obj_t *score_label;
 static lv_obj_t *game_over_label;
-static lv_obj_t *grid_cells[COLS][ROWS];
+
+// Board: white road and logs are the background, water and cars are black
+#define TILE_WATER 1
+#define TILE_CAR 2
+#define TILE_GOAL 3
+#define TILE_FROG 4
+
+static const TileDef tiles[] = {
+    [TILE_WATER] = {.shape = TILE_FILL},
+    [TILE_CAR] = {.shape = TILE_FILL},
+    [TILE_GOAL] = {.shape = TILE_FILL, .inset = 6},
+    [TILE_FROG] = {.shape = TILE_ROUND, .inset = 2},
+};
+static TileMap board;
 
 static void init_lanes(void) {
   // Top (Goal)
@@ -52,10 +105,11 @@ static void init_lanes(void) {
   for (int y = 1; y <= 5; y++) {
     lanes[y].type = LANE_RIVER;
     lanes[y].direction = (y % 2 == 0) ? 1 : -1;
-    lanes[y].speed = 150 + (sys_rand32_get() % 100);
-    lanes[y].obstacle_count = 2 + (sys_rand32_get() % 2); // 2-3 logs
+    lanes[y].speed = 150 + (app_rand32() % 100);
+    lanes[y].timer = 0;
+    lanes[y].obstacle_count = 2 + (app_rand32() % 2); // 2-3 logs
     for (int i = 0; i < lanes[y].obstacle_count; i++) {
-      lanes[y].obstacles[i].x = (i * 6) + (sys_rand32_get() % 3);
+      lanes[y].obstacles[i].x = (i * 6) + (app_rand32() % 3);
       lanes[y].obstacles[i].width = 3; // Log width
       lanes[y].obstacles[i].type = 1;  // Log
     }
@@ -68,10 +122,11 @@ static void init_lanes(void) {
   for (int y = 7; y <= 11; y++) {
     lanes[y].type = LANE_ROAD;
     lanes[y].direction = (y % 2 != 0) ? 1 : -1;
-    lanes[y].speed = 100 + (sys_rand32_get() % 150);
-    lanes[y].obstacle_count = 2 + (sys_rand32_get() % 2);
+    lanes[y].speed = 100 + (app_rand32() % 150);
+    lanes[y].timer = 0;
+    lanes[y].obstacle_count = 2 + (app_rand32() % 2);
     for (int i = 0; i < lanes[y].obstacle_count; i++) {
-      lanes[y].obstacles[i].x = (i * 7) + (sys_rand32_get() % 4);
+      lanes[y].obstacles[i].x = (i * 7) + (app_rand32() % 4);
       lanes[y].obstacles[i].width = 1; // Car width
       lanes[y].obstacles[i].type = 0;  // Car
     }
@@ -83,36 +138,27 @@ static void init_lanes(void) {
   }
 }
 
-static void set_cell_color(int x, int y, lv_color_t color) {
-  if (x >= 0 && x < COLS && y >= 0 && y < ROWS && grid_cells[x][y]) {
-    lv_obj_set_style_bg_color(grid_cells[x][y], color, 0);
-  }
-}
-
 static void render_game(void) {
   for (int y = 0; y < ROWS; y++) {
     Lane *l = &lanes[y];
 
     // Base Lane Color
-    lv_color_t bg_color = lv_color_white();
-    if (l->type == LANE_ROAD)
-      bg_color = lv_color_white(); // White Road
-    else if (l->type == LANE_RIVER)
-      bg_color = lv_color_black(); // Black River (Water)
+    uint8_t bg_tile = TILE_EMPTY; // White Road
+    if (l->type == LANE_RIVER)
+      bg_tile = TILE_WATER; // Black River (Water)
     else if (l->type == LANE_GOAL)
-      bg_color = lv_palette_lighten(LV_PALETTE_GREY, 2);
+      bg_tile = TILE_GOAL;
 
     // Draw Lane Background
     for (int x = 0; x < COLS; x++) {
-      set_cell_color(x, y, bg_color);
+      tile_map_set(&board, x, y, bg_tile);
     }
 
     // Draw Obstacles
     if (l->type == LANE_ROAD || l->type == LANE_RIVER) {
       for (int i = 0; i < l->obstacle_count; i++) {
         Obstacle *o = &l->obstacles[i];
-        lv_color_t obj_color =
-            (o->type == 1) ? lv_color_white() : lv_color_black();
+        uint8_t obj_tile = (o->type == 1) ? TILE_EMPTY : TILE_CAR;
 
         // If Log on River -> White Log on Black Water
         // If Car on Road -> Black Car on White Road
@@ -128,14 +174,16 @@ static void render_game(void) {
           if (draw_x < 0)
             draw_x += COLS;
 
-          set_cell_color(draw_x, y, obj_color);
+          tile_map_set(&board, draw_x, y, obj_tile);
         }
       }
     }
   }
 
   // Draw Player
-  set_cell_color(player_x, player_y, lv_color_black()); // Black Frog
+  tile_map_set(&board, player_x, player_y, TILE_FROG); // Black Frog
+
+  tile_map_commit(&board);
 }
 
 static void check_collision(void) {
@@ -149,7 +197,7 @@ static void check_collision(void) {
       // Assuming no wrapping overlap for now
       if (player_x >= o->x && player_x < o->x + o->width) {
         game_over = true;
-        play_beep_die();
+        audio_play_sfx(&sfx_squash);
         return;
       }
     }
@@ -165,7 +213,7 @@ static void check_collision(void) {
     }
     if (!on_log) {
       game_over = true; // Drowned
-      play_beep_die();
+      audio_play_sfx(&sfx_splash);
     }
   } else if (l->type == LANE_GOAL) {
     lv_label_set_text(game_over_label, "WINNER!\nUP to Restart");
@@ -174,7 +222,7 @@ static void check_collision(void) {
     game_over = true;
     score += 100;
     lv_label_set_text_fmt(score_label, "Score: %d", score);
-    play_beep_eat();
+    audio_play_sfx(&sfx_win);
   }
 }
 
@@ -194,23 +242,15 @@ static void reset_game(void) {
   render_game();
 }
 
-static void froggr_enter(void) {
-  main_cont = lv_obj_create(lv_scr_act());
+static void froggr_enter(lv_obj_t *scr) {
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_scrollbar_mode(main_cont, LV_SCROLLBAR_MODE_OFF);
 
-  // Grid
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      lv_obj_t *cell = lv_obj_create(main_cont);
-      lv_obj_set_size(cell, CELL_SIZE, CELL_SIZE);
-      lv_obj_set_pos(cell, x * CELL_SIZE, y * CELL_SIZE);
-      lv_obj_set_style_border_width(cell, 0, 0);
-      lv_obj_set_style_radius(cell, 0, 0);
-      grid_cells[x][y] = cell;
-    }
-  }
+  // Board
+  tile_map_create(&board, main_cont, COLS, ROWS, CELL_SIZE, tiles,
+                  ARRAY_SIZE(tiles));
 
   score_label = lv_label_create(main_cont);
   lv_obj_align(score_label, LV_ALIGN_TOP_RIGHT, -10, 5);
@@ -227,73 +267,75 @@ static void froggr_enter(void) {
   reset_game();
 }
 
-static void froggr_update(void) {
-  int btn_up_curr = gpio_pin_get_dt(&btn_up);
-  static int btn_up_prev_fr = 0;
-  static int btn_right_prev = 0;
-  static int btn_left_prev = 0;
-  static int btn_down_prev = 0;
+static void froggr_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
   if (game_over) {
-    if (btn_up_curr && !btn_up_prev_fr) {
+    if (evt->button == BTN_UP) {
       reset_game();
     }
-    btn_up_prev_fr = btn_up_curr;
     return;
   }
 
   // Input
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right);
-  int btn_down_curr = gpio_pin_get_dt(&btn_down);
-
   bool moved = false;
 
-  if (btn_up_curr && !btn_up_prev_fr) {
+  switch (evt->button) {
+  case BTN_UP:
     if (player_y > 0) {
       player_y--;
       score += 10;
       moved = true;
     }
-  }
-  if (btn_down_curr && !btn_down_prev) {
+    break;
+  case BTN_DOWN:
     if (player_y < ROWS - 1) {
       player_y++;
       score -= 5;
       moved = true;
     }
-  }
-  if (btn_left_curr && !btn_left_prev) {
+    break;
+  case BTN_LEFT:
     if (player_x > 0) {
       player_x--;
       moved = true;
     }
-  }
-  if (btn_right_curr && !btn_right_prev) {
+    break;
+  case BTN_RIGHT:
     if (player_x < COLS - 1) {
       player_x++;
       moved = true;
     }
+    break;
+  default:
+    break;
   }
 
-  btn_up_prev_fr = btn_up_curr;
-  btn_left_prev = btn_left_curr;
-  btn_right_prev = btn_right_curr;
-  btn_down_prev = btn_down_curr;
-
   if (moved) {
-    play_beep_move();
+    audio_play_sfx(&sfx_hop);
     lv_label_set_text_fmt(score_label, "Score: %d", score);
+    check_collision();
+    if (!game_over) {
+      render_game();
+    }
   }
+}
+
+// Fixed 50ms tick, each lane moves once its own speed has accumulated
+static void froggr_tick(void) {
+  if (game_over)
+    return;
 
-  // Update Lanes
-  int64_t now = k_uptime_get();
-  bool need_render = moved;
+  bool need_render = false;
 
   for (int y = 0; y < ROWS; y++) {
     Lane *l = &lanes[y];
     if (l->type == LANE_ROAD || l->type == LANE_RIVER) {
-      if (now - l->last_move > l->speed) {
+      l->timer += TICK_MS;
+      if (l->timer >= l->speed) {
+        l->timer -= l->speed;
+
         // Move Obstacles
         for (int i = 0; i < l->obstacle_count; i++) {
           l->obstacles[i].x += l->direction;
@@ -313,7 +355,6 @@ static void froggr_update(void) {
             player_x = COLS - 1;
         }
 
-        l->last_move = now;
         need_render = true;
       }
     }
@@ -328,6 +369,9 @@ static void froggr_update(void) {
   }
 }
 
+// Screen is retained, the crossing continues where it was left
+static void froggr_resume(void) {}
+
 static void froggr_exit(void) {
   if (main_cont) {
     lv_obj_del(main_cont);
@@ -337,5 +381,9 @@ static void froggr_exit(void) {
 
 App froggr_app = {.name = "Froggr",
                   .enter = froggr_enter,
-                  .update = froggr_update,
-                  .exit = froggr_exit};
+                  .input = froggr_input,
+                  .exit = froggr_exit,
+                  .resume = froggr_resume,
+                  .tick_ms = TICK_MS,
+                  .tick = froggr_tick,
+                  .refresh = REFRESH_FAST};
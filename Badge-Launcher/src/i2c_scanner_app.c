@@ -4,14 +4,14 @@
 
 LOG_MODULE_REGISTER(i2c_scanner_app, LOG_LEVEL_INF);
 
-static void i2c_scanner_enter(void);
-static void i2c_scanner_update(void);
+static void i2c_scanner_enter(lv_obj_t *scr);
+static void i2c_scanner_input(const ButtonEvent *evt);
 static void i2c_scanner_exit(void);
 
 // App Structure
 App i2c_scanner_app = {.name = "I2C Scanner",
                        .enter = i2c_scanner_enter,
-                       .update = i2c_scanner_update,
+                       .input = i2c_scanner_input,
                        .exit = i2c_scanner_exit};
 
 // --- UI Elements ---
@@ -31,7 +31,6 @@ static ScannerState current_state = STATE_SELECT_BUS;
 static int selected_bus_index = 0; // 0=I2C0, 1=I2C1, 2=I2C2
 
 static const struct device *i2c_devs[3];
-static int64_t last_action_time = 0;
 
 static void init_i2c_devs(void) {
   i2c_devs[0] = DEVICE_DT_GET(DT_ALIAS(i2c0));
@@ -152,12 +151,11 @@ static void scan_bus(int bus_idx) {
   }
 }
 
-static void i2c_scanner_enter(void) {
+static void i2c_scanner_enter(lv_obj_t *scr) {
   current_state = STATE_SELECT_BUS;
   selected_bus_index = 0;
-  last_action_time = k_uptime_get(); // Prevent stale clicks
 
-  main_cont = lv_obj_create(lv_scr_act());
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_flex_flow(main_cont, LV_FLEX_FLOW_COLUMN);
@@ -218,49 +216,20 @@ static void i2c_scanner_enter(void) {
   lv_obj_set_style_text_color(hint_label, lv_color_black(), 0); // Black Text
 }
 
-static void i2c_scanner_update(void) {
-  // Read GPIOs
-  static const struct gpio_dt_spec btn_up =
-      GPIO_DT_SPEC_GET(DT_ALIAS(btn_up), gpios);
-  static const struct gpio_dt_spec btn_left =
-      GPIO_DT_SPEC_GET(DT_ALIAS(btn_left), gpios);
-  static const struct gpio_dt_spec btn_right =
-      GPIO_DT_SPEC_GET(DT_ALIAS(btn_right), gpios);
-  static const struct gpio_dt_spec btn_select =
-      GPIO_DT_SPEC_GET(DT_ALIAS(btn_select), gpios);
-
-  // Debounce / Edge State
-  static int up_prev = 0, right_prev = 0, left_prev = 0, select_prev = 0;
-
-  int up = gpio_pin_get_dt(&btn_up);
-  int right = gpio_pin_get_dt(&btn_right);
-  int left = gpio_pin_get_dt(&btn_left);
-  int select = gpio_pin_get_dt(&btn_select);
-  int64_t now = k_uptime_get();
-
-  // Basic Debounce (ignore fast repeats)
-  if (now - last_action_time < 200) { // 200ms dead time
-    up_prev = up;
-    right_prev = right;
-    left_prev = left;
-    select_prev = select;
+static void i2c_scanner_input(const ButtonEvent *evt) {
+  // Holding LEFT/RIGHT cycles through the buses, the rest acts on the press
+  bool cycle = current_state == STATE_SELECT_BUS &&
+               (evt->button == BTN_LEFT || evt->button == BTN_RIGHT);
+  if (evt->action != BTN_PRESSED && !(cycle && evt->action == BTN_REPEAT))
     return;
-  }
+  int steps = (evt->action == BTN_REPEAT) ? evt->steps : 1;
 
   if (current_state == STATE_SELECT_BUS) {
-    if (right && !right_prev) {
-      selected_bus_index++;
-      if (selected_bus_index > 2)
-        selected_bus_index = 0;
-      last_action_time = now;
-    }
+    if (evt->button == BTN_RIGHT)
+      selected_bus_index = (selected_bus_index + steps) % 3;
 
-    if (left && !left_prev) {
-      selected_bus_index--;
-      if (selected_bus_index < 0)
-        selected_bus_index = 2;
-      last_action_time = now;
-    }
+    if (evt->button == BTN_LEFT)
+      selected_bus_index = (selected_bus_index + 3 - steps % 3) % 3;
 
     // Highlight logic
     highlight_btn(btn_i2c0, selected_bus_index == 0);
@@ -268,9 +237,8 @@ static void i2c_scanner_update(void) {
     highlight_btn(btn_i2c2, selected_bus_index == 2);
 
     // Confirm Selection - UP or SELECT BUTTON
-    if ((up && !up_prev) || (select && !select_prev)) {
+    if (evt->button == BTN_UP || evt->button == BTN_SELECT) {
       current_state = STATE_SCANNING;
-      last_action_time = now;
       scan_bus(selected_bus_index);
       current_state = STATE_RESULTS;
 
@@ -278,19 +246,13 @@ static void i2c_scanner_update(void) {
     }
   } else if (current_state == STATE_RESULTS) {
     // Return to select - LEFT ONLY
-    if (left && !left_prev) {
+    if (evt->button == BTN_LEFT) {
       current_state = STATE_SELECT_BUS;
-      last_action_time = now;
       lv_label_set_text(status_label, "Select a Bus");
       lv_label_set_text(hint_label, "");
       lv_obj_clean(result_area);
     }
   }
-
-  up_prev = up;
-  right_prev = right;
-  left_prev = left;
-  select_prev = select;
 }
 
 static void i2c_scanner_exit(void) {
@@ -0,0 +1,165 @@
+#include "image_1bpp.h"
+#include "asset_cache.h"
+
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+#define PALETTE_SIZE 8    // Two ARGB8888 entries ahead of the pixels
+#define STRIP_PIXELS 3200 // Eight full-width rows of the panel
+
+/* Decoded rows, one strip at a time (the launcher thread draws alone) */
+static uint8_t strip_buf[STRIP_PIXELS] __aligned(4);
+static lv_draw_buf_t strip;
+
+/* Stats */
+static uint32_t opens;
+static uint32_t strips;
+static uint32_t rows_decoded;
+static uint32_t bytes_read;
+static uint64_t decode_cycles;
+
+static const lv_image_dsc_t *i1_source(const lv_image_decoder_dsc_t *dsc) {
+  const lv_image_dsc_t *img = dsc->src;
+
+  if (dsc->src_type != LV_IMAGE_SRC_VARIABLE ||
+      img->header.cf != LV_COLOR_FORMAT_I1)
+    return NULL;
+  return img;
+}
+
+static uint32_t i1_stride(const lv_image_header_t *header) {
+  return header->stride ? header->stride : DIV_ROUND_UP(header->w, 8);
+}
+
+static bool compressed(const lv_image_dsc_t *img) {
+  return img->header.flags & LV_IMAGE_FLAGS_COMPRESSED;
+}
+
+static lv_result_t info_cb(lv_image_decoder_t *decoder,
+                           lv_image_decoder_dsc_t *dsc,
+                           lv_image_header_t *header) {
+  const lv_image_dsc_t *img = i1_source(dsc);
+
+  if (!img)
+    return LV_RESULT_INVALID;
+  uint32_t available =
+      compressed(img) ? asset_cache_unpacked_size(img) : img->data_size;
+  if (available < PALETTE_SIZE + i1_stride(&img->header) * img->header.h)
+    return LV_RESULT_INVALID;
+  *header = img->header;
+  header->flags &= ~LV_IMAGE_FLAGS_COMPRESSED; // Unpacked here, not by LVGL
+  return LV_RESULT_OK;
+}
+
+static lv_result_t open_cb(lv_image_decoder_t *decoder,
+                           lv_image_decoder_dsc_t *dsc) {
+  const lv_image_dsc_t *img = i1_source(dsc);
+  const uint8_t *data = img->data;
+
+  // Compressed sprites are unpacked once and kept
+  if (compressed(img) && !(data = asset_cache_acquire(img)))
+    return LV_RESULT_INVALID;
+
+  dsc->user_data = (void *)data; // Palette, then the packed rows
+  dsc->decoded = NULL;           // Drawn through get_area in strips
+  opens++;
+  return LV_RESULT_OK;
+}
+
+static lv_result_t get_area_cb(lv_image_decoder_t *decoder,
+                               lv_image_decoder_dsc_t *dsc,
+                               const lv_area_t *full_area,
+                               lv_area_t *decoded_area) {
+  const lv_image_dsc_t *img = dsc->src;
+  int32_t w = lv_area_get_width(full_area);
+  int32_t rows = MAX(STRIP_PIXELS / w, 1);
+
+  if (w > STRIP_PIXELS)
+    return LV_RESULT_INVALID;
+
+  // First call starts at the top of the area, the next ones continue below
+  if (decoded_area->y1 == LV_COORD_MIN) {
+    *decoded_area = *full_area;
+    decoded_area->y2 = decoded_area->y1 - 1;
+  }
+  decoded_area->y1 = decoded_area->y2 + 1;
+  decoded_area->y2 = MIN(decoded_area->y1 + rows - 1, full_area->y2);
+  if (decoded_area->y1 > full_area->y2)
+    return LV_RESULT_INVALID;
+
+  uint32_t start = k_cycle_get_32();
+  const uint8_t *pal = dsc->user_data; // b, g, r, a per entry
+  const uint8_t *pixels = pal + PALETTE_SIZE;
+  uint32_t stride = i1_stride(&img->header);
+
+  // Gray level of each index, whatever way round the palette is
+  uint8_t dark = lv_color_luminance(lv_color_make(pal[2], pal[1], pal[0]));
+  uint8_t lit = lv_color_luminance(lv_color_make(pal[6], pal[5], pal[4]));
+  int32_t h = lv_area_get_height(decoded_area);
+
+  lv_draw_buf_init(&strip, w, h, LV_COLOR_FORMAT_L8, w, strip_buf,
+                   sizeof(strip_buf));
+  for (int32_t y = 0; y < h; y++) {
+    const uint8_t *src = pixels + (decoded_area->y1 + y) * stride;
+    uint8_t *dst = strip_buf + y * w;
+
+    for (int32_t x = full_area->x1; x <= full_area->x2; x++)
+      *dst++ = (src[x / 8] & (0x80 >> (x % 8))) ? lit : dark;
+  }
+  dsc->decoded = &strip;
+
+  strips++;
+  rows_decoded += h;
+  bytes_read += h * (full_area->x2 / 8 - full_area->x1 / 8 + 1);
+  decode_cycles += k_cycle_get_32() - start;
+  return LV_RESULT_OK;
+}
+
+static void close_cb(lv_image_decoder_t *decoder,
+                     lv_image_decoder_dsc_t *dsc) {
+  const lv_image_dsc_t *img = dsc->src;
+
+  if (compressed(img))
+    asset_cache_release(img);
+  dsc->decoded = NULL; // The strip buffer is static
+}
+
+void image_1bpp_init(void) {
+  lv_image_decoder_t *decoder = lv_image_decoder_create();
+
+  if (!decoder) {
+    LOG_ERR("No 1-bpp image decoder, sprites go through LVGL's");
+    return;
+  }
+  lv_image_decoder_set_info_cb(decoder, info_cb);
+  lv_image_decoder_set_open_cb(decoder, open_cb);
+  lv_image_decoder_set_get_area_cb(decoder, get_area_cb);
+  lv_image_decoder_set_close_cb(decoder, close_cb);
+}
+
+/* Shell: badge images [reset] */
+static int cmd_images(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Usage: badge images [reset]");
+      return -EINVAL;
+    }
+    opens = strips = rows_decoded = bytes_read = 0;
+    decode_cycles = 0;
+    return 0;
+  }
+
+  shell_print(sh, "1-bpp images opened: %u, strips: %u, rows: %u", opens,
+              strips, rows_decoded);
+  shell_print(sh, "Read %u bytes of packed pixels, decode time %u us",
+              bytes_read, (uint32_t)k_cyc_to_us_ceil64(decode_cycles));
+  shell_print(sh, "Strip buffer: %u bytes", (uint32_t)sizeof(strip_buf));
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), images, NULL,
+                 "1-bpp image decode counts\n"
+                 "Usage: badge images [reset]",
+                 cmd_images, 1, 1);
@@ -0,0 +1,21 @@
+#ifndef IMAGE_1BPP_H
+#define IMAGE_1BPP_H
+
+#include "app_shared.h"
+
+/*
+ * Sprite assets are LV_COLOR_FORMAT_I1: a two-entry palette and 8 pixels a
+ * byte (convert_sprites.py), an eighth of the L8 they used to be. LVGL's
+ * own decoder would expand an indexed image into a whole ARGB8888 buffer
+ * before drawing it (480 KB for the 400x300 badge image), so this one takes
+ * over I1 images in memory and hands the renderer L8 strips of only the
+ * area being redrawn, decoded straight from flash into one small static
+ * buffer. Compressed sprites are unpacked whole once and kept in the asset
+ * cache (asset_cache.h); plain ones are read in place. Counts are on
+ * "badge images".
+ */
+
+/* Registers the decoder ahead of LVGL's own. Call once LVGL is up. */
+void image_1bpp_init(void);
+
+#endif
@@ -0,0 +1,390 @@
+#include "input_log.h"
+#include "buttons.h"
+#include "event_loop.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/random/random.h>
+#include <zephyr/shell/shell.h>
+#ifdef CONFIG_FILE_SYSTEM
+#include <zephyr/fs/fs.h>
+#endif
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+/*
+ * Log layout: LogHeader, then one record per edge: the ms since the previous
+ * edge as an unsigned LEB128 varint, then (button << 1) | pressed. Typical
+ * play stays well under 3 bytes per edge.
+ */
+#define LOG_MAGIC "BINP"
+#define LOG_VERSION 1
+#define MAX_RECORD_BYTES 6 // 5 varint bytes for 32-bit deltas, 1 edge byte
+
+typedef struct {
+  char magic[4];
+  uint8_t version;
+  uint8_t reserved[3];
+  uint32_t seed;        // app_srand() value the app started from
+  uint32_t duration_ms; // Screen up to the app being left (or stop)
+  uint32_t data_len;    // Bytes of edge records after the header
+  char app[24];         // Recorded app, replay warns on a mismatch
+} __packed LogHeader;
+
+static struct {
+  LogHeader hdr;
+  uint8_t data[CONFIG_BADGE_INPUT_LOG_SIZE];
+} __packed input_log;
+
+typedef enum { SESSION_NONE, SESSION_RECORD, SESSION_REPLAY } SessionMode;
+
+/* Shell requests, picked up by the launcher thread in input_log_poll() */
+enum { REQ_NONE, REQ_RECORD, REQ_REPLAY, REQ_STOP };
+static atomic_t request;
+static atomic_t replay_speed; // Multiple of real time, 0 = flat out
+
+/* Session state, launcher thread only */
+static SessionMode mode;
+static bool shown;      // Session app is up, the log clock is running
+static int64_t t0;      // Recording: uptime at time zero
+static int64_t last_ms; // Recording: time of the previous edge
+static uint32_t cursor; // Replay: read position in data
+static int64_t next_at; // Replay: time of the edge at cursor
+static uint32_t edges;
+static int64_t replay_started; // Real uptime, for the speed-up figure
+
+/* App clock and PRNG (input thread reads the clock too) */
+static bool clock_virtual;
+static int64_t clock_now;
+static uint32_t rand_state = 1;
+
+int64_t app_uptime_get(void) {
+  return clock_virtual ? clock_now : k_uptime_get();
+}
+
+/* xorshift32: cheap, and the whole state is the seed */
+uint32_t app_rand32(void) {
+  uint32_t x = rand_state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rand_state = x;
+  return x;
+}
+
+void app_srand(uint32_t seed) { rand_state = seed ? seed : 1; }
+
+static bool append_edge(const ButtonEvent *evt) {
+  // When the edge was reported, not when the launcher got to it
+  int64_t now = MAX(evt->uptime_ms - t0, last_ms);
+  uint32_t delta = (uint32_t)MIN(now - last_ms, UINT32_MAX);
+  uint8_t *out = &input_log.data[input_log.hdr.data_len];
+
+  if (input_log.hdr.data_len + MAX_RECORD_BYTES > sizeof(input_log.data))
+    return false;
+
+  do {
+    *out++ = (delta & 0x7f) | (delta > 0x7f ? 0x80 : 0);
+    delta >>= 7;
+  } while (delta);
+  *out++ = (evt->button << 1) | (evt->action == BTN_PRESSED);
+
+  input_log.hdr.data_len = out - input_log.data;
+  last_ms = now;
+  edges++;
+  return true;
+}
+
+/* Decodes the record at cursor into next_at, INT64_MAX at the end */
+static void peek_edge(void) {
+  uint32_t delta = 0;
+  uint32_t pos = cursor;
+
+  for (int shift = 0; pos < input_log.hdr.data_len; shift += 7) {
+    uint8_t b = input_log.data[pos++];
+
+    delta |= (uint32_t)(b & 0x7f) << shift;
+    if (!(b & 0x80)) {
+      if (pos < input_log.hdr.data_len) {
+        next_at += delta;
+        return;
+      }
+      break;
+    }
+  }
+  next_at = INT64_MAX;
+}
+
+static void take_edge(void) {
+  // Skip the varint peek_edge() already applied, then the edge byte
+  while (input_log.data[cursor++] & 0x80)
+    ;
+  uint8_t edge = input_log.data[cursor++];
+
+  if ((edge >> 1) < BTN_COUNT)
+    buttons_inject(edge >> 1, edge & 1, next_at); // At its recorded time
+  edges++;
+  peek_edge();
+}
+
+static void end_session(void) {
+  if (mode == SESSION_RECORD && shown) {
+    input_log.hdr.duration_ms = k_uptime_get() - t0;
+    LOG_INF("Recorded %u edges of %s in %u ms (%u bytes)", edges,
+            input_log.hdr.app, input_log.hdr.duration_ms,
+            input_log.hdr.data_len);
+  } else if (mode == SESSION_REPLAY) {
+    int64_t real_ms = MAX(k_uptime_get() - replay_started, 1);
+
+    clock_virtual = false;
+    buttons_set_live(true);
+    LOG_INF("Replayed %u edges, %lld ms of app time in %lld ms (%lldx)",
+            edges, (long long)clock_now, (long long)real_ms,
+            (long long)(clock_now / real_ms));
+  }
+  mode = SESSION_NONE;
+  shown = false;
+}
+
+bool input_log_poll(const App *app) {
+  int req = atomic_set(&request, REQ_NONE);
+
+  if (req == REQ_STOP) {
+    if (mode == SESSION_REPLAY)
+      return_to_menu(); // App state rode the virtual clock, start over
+    else
+      end_session();
+    return false;
+  }
+
+  if (req != REQ_RECORD && req != REQ_REPLAY)
+    return false;
+
+  if (!app) {
+    LOG_WRN("Open the app to record or replay first");
+    return false;
+  }
+  end_session();
+  mode = (req == REQ_RECORD) ? SESSION_RECORD : SESSION_REPLAY;
+  return true;
+}
+
+void input_log_session_begin(const App *app) {
+  edges = 0;
+
+  if (mode == SESSION_RECORD) {
+    memcpy(input_log.hdr.magic, LOG_MAGIC, sizeof(input_log.hdr.magic));
+    input_log.hdr.version = LOG_VERSION;
+    input_log.hdr.seed = sys_rand32_get();
+    input_log.hdr.duration_ms = 0;
+    input_log.hdr.data_len = 0;
+    strncpy(input_log.hdr.app, app->name, sizeof(input_log.hdr.app) - 1);
+  } else if (mode == SESSION_REPLAY) {
+    if (strncmp(input_log.hdr.app, app->name, sizeof(input_log.hdr.app) - 1))
+      LOG_WRN("Replaying %s input into %s", input_log.hdr.app, app->name);
+
+    // Apps see time zero until their screen is up, like the recording
+    clock_virtual = true;
+    clock_now = 0;
+    buttons_set_live(false);
+    cursor = 0;
+    next_at = 0;
+    peek_edge();
+  } else {
+    return;
+  }
+  app_srand(input_log.hdr.seed);
+}
+
+void input_log_app_shown(void) {
+  if (mode == SESSION_NONE || shown)
+    return;
+
+  shown = true;
+  t0 = k_uptime_get();
+  last_ms = 0;
+  replay_started = t0;
+}
+
+bool input_log_app_left(void) {
+  bool replayed = input_log_replaying();
+
+  if (shown)
+    end_session();
+  return replayed;
+}
+
+void input_log_record(const ButtonEvent *evt) {
+  if (mode != SESSION_RECORD || !shown)
+    return;
+
+  if (!append_edge(evt)) {
+    LOG_WRN("Input log full (CONFIG_BADGE_INPUT_LOG_SIZE), recording stopped");
+    end_session();
+  }
+}
+
+bool input_log_replaying(void) { return mode == SESSION_REPLAY && shown; }
+
+void input_log_advance(void) {
+  int64_t deadline = event_loop_take_deadline();
+  int64_t target = MIN(MIN(deadline, next_at), input_log.hdr.duration_ms);
+  int speed = atomic_get(&replay_speed);
+
+  if (target > clock_now) {
+    if (speed > 0)
+      k_sleep(K_MSEC((target - clock_now) / speed));
+    clock_now = target;
+  }
+
+  while (next_at <= clock_now)
+    take_edge();
+
+  // Past the recorded session: hand the badge back
+  if (next_at == INT64_MAX && clock_now >= input_log.hdr.duration_ms)
+    return_to_menu();
+}
+
+/* Shell: badge record [start|stop|save <path>], badge replay [...] */
+#ifdef CONFIG_FILE_SYSTEM
+static int save_log(const char *path) {
+  struct fs_file_t file;
+  size_t len = sizeof(input_log.hdr) + input_log.hdr.data_len;
+
+  fs_file_t_init(&file);
+  int rc = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+  if (rc < 0)
+    return rc;
+
+  ssize_t written = fs_write(&file, &input_log, len);
+  fs_close(&file);
+  return (written == len) ? 0 : -EIO;
+}
+
+static int load_log(const char *path) {
+  struct fs_file_t file;
+  LogHeader hdr;
+
+  fs_file_t_init(&file);
+  int rc = fs_open(&file, path, FS_O_READ);
+  if (rc < 0)
+    return rc;
+
+  rc = -EINVAL;
+  if (fs_read(&file, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+      memcmp(hdr.magic, LOG_MAGIC, sizeof(hdr.magic)) == 0 &&
+      hdr.version == LOG_VERSION && hdr.data_len <= sizeof(input_log.data) &&
+      fs_read(&file, input_log.data, hdr.data_len) == hdr.data_len) {
+    hdr.app[sizeof(hdr.app) - 1] = '\0';
+    input_log.hdr = hdr;
+    rc = 0;
+  }
+  fs_close(&file);
+  return rc;
+}
+#endif
+
+static void print_log_info(const struct shell *sh) {
+  if (input_log.hdr.version != LOG_VERSION) {
+    shell_print(sh, "Log: empty");
+    return;
+  }
+  shell_print(sh, "Log: %s, seed 0x%08x, %u ms, %u / %u bytes",
+              input_log.hdr.app, input_log.hdr.seed,
+              input_log.hdr.duration_ms, input_log.hdr.data_len,
+              (unsigned)sizeof(input_log.data));
+}
+
+static int cmd_record(const struct shell *sh, size_t argc, char **argv) {
+  if (argc == 1) {
+    shell_print(sh, "Session: %s",
+                mode == SESSION_RECORD   ? "recording"
+                : mode == SESSION_REPLAY ? "replaying"
+                                         : "none");
+    print_log_info(sh);
+    return 0;
+  }
+
+  if (strcmp(argv[1], "start") == 0) {
+    atomic_set(&request, REQ_RECORD);
+    wake_launcher();
+    shell_print(sh, "Restarting the foreground app, recording");
+    return 0;
+  }
+
+  if (strcmp(argv[1], "stop") == 0) {
+    atomic_set(&request, REQ_STOP);
+    wake_launcher();
+    return 0;
+  }
+
+#ifdef CONFIG_FILE_SYSTEM
+  if (strcmp(argv[1], "save") == 0 && argc > 2) {
+    if (mode != SESSION_NONE) {
+      shell_error(sh, "Stop the session first");
+      return -EBUSY;
+    }
+    int rc = save_log(argv[2]);
+    if (rc < 0) {
+      shell_error(sh, "Save failed (%d)", rc);
+      return rc;
+    }
+    print_log_info(sh);
+    return 0;
+  }
+#endif
+
+  shell_error(sh, "Usage: badge record [start|stop|save <path>]");
+  return -EINVAL;
+}
+
+static int cmd_replay(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "stop") == 0) {
+    atomic_set(&request, REQ_STOP);
+    wake_launcher();
+    return 0;
+  }
+
+#ifdef CONFIG_FILE_SYSTEM
+  if (argc > 2 && strcmp(argv[1], "load") == 0) {
+    if (mode != SESSION_NONE) {
+      shell_error(sh, "Stop the session first");
+      return -EBUSY;
+    }
+    int rc = load_log(argv[2]);
+    if (rc < 0) {
+      shell_error(sh, "Load failed (%d)", rc);
+      return rc;
+    }
+    print_log_info(sh);
+    return 0;
+  }
+#endif
+
+  int speed = (argc > 1) ? atoi(argv[1]) : 0;
+  if (speed < 0) {
+    shell_error(sh, "Usage: badge replay [speed|stop|load <path>]");
+    return -EINVAL;
+  }
+  if (input_log.hdr.version != LOG_VERSION) {
+    shell_error(sh, "Nothing recorded");
+    return -ENOENT;
+  }
+
+  atomic_set(&replay_speed, speed);
+  atomic_set(&request, REQ_REPLAY);
+  wake_launcher();
+  print_log_info(sh);
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), record, NULL,
+                 "Record button input into the foreground app from a cold "
+                 "start\nUsage: badge record [start|stop|save <path>]",
+                 cmd_record, 1, 2);
+SHELL_SUBCMD_ADD((badge), replay, NULL,
+                 "Replay the recorded input into the foreground app (speed: "
+                 "multiple of real time, 0 = flat out)\n"
+                 "Usage: badge replay [speed|stop|load <path>]",
+                 cmd_replay, 1, 2);
@@ -0,0 +1,47 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include "app_shared.h"
+
+/*
+ * Input record/replay ("badge record", "badge replay"). A session restarts
+ * the foreground app from scratch on a known app_rand32() seed. Recording
+ * logs every button edge with its app time since the screen came up, replay
+ * feeds the same edges back to whichever app is in front on a virtual
+ * clock that jumps straight to the next deadline or edge. Replays of one
+ * log are identical on every build and run as fast as the app can render.
+ */
+
+/* Seeds app_rand32() outside of sessions */
+void app_srand(uint32_t seed);
+
+/*
+ * Launcher loop, while idle. Returns true when a session wants app (NULL
+ * for the menu, which cannot be recorded) restarted from scratch.
+ */
+bool input_log_poll(const App *app);
+
+/* Cold start of the session app, before its screen is built */
+void input_log_session_begin(const App *app);
+
+/* An app's screen is up: time zero of a session log */
+void input_log_app_shown(void);
+
+/*
+ * The foreground app is being left: ends a running session. Returns true
+ * after a replay, the app's state then belongs to the virtual clock.
+ */
+bool input_log_app_left(void);
+
+/* Edge popped from the button queue */
+void input_log_record(const ButtonEvent *evt);
+
+bool input_log_replaying(void);
+
+/*
+ * Stands in for event_loop_wait() while replaying: moves the virtual clock
+ * to the next app deadline or logged edge and queues the edges now due.
+ */
+void input_log_advance(void);
+
+#endif
@@ -1,44 +1,50 @@
 #include "about_app.h"
 #include "app_shared.h"
+#include "audio.h"
 #include "badge_mode_app.h"
 #include "beagle_man.h"
 #include "beagle_run.h"
 #include "beaglegotchi.h"
 #include "brick_breaker.h"
 #include "button_test.h"
+#include "buttons.h"
 #include "chip_tunez.h"
+#include "debounce.h"
 #include "dvd_app.h"
+#include "event_loop.h"
+#include "frame_stats.h"
 #include "froggr.h"
 #include "i2c_scanner_app.h"
+#include "image_1bpp.h"
+#include "input_log.h"
+#include "mixer.h"
+#include "refresh.h"
+#include "screen_cache.h"
 #include "serial_monitor.h"
 #include "shutdown_app.h"
 #include "snake_game.h"
+#include "sound_app.h"
 #include "space_invaders.h"
 #include "timer_app.h"
+#include "tone.h"
 
 #include <zephyr/drivers/display.h>
 #include <zephyr/random/random.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/shell/shell.h>
 #include <zephyr/version.h>
 
 LOG_MODULE_REGISTER(badge_launcher);
 
+/* Root of the "badge" shell command, subcommands live with their modules */
+SHELL_SUBCMD_SET_CREATE(badge_cmds, (badge));
+SHELL_CMD_REGISTER(badge, &badge_cmds, "Badge launcher diagnostics", NULL);
+
 /* Assets */
 LV_IMG_DECLARE(ti_logo);
 LV_IMG_DECLARE(beagle);
 
 /* Hardware Definitions */
-const struct gpio_dt_spec btn_up = GPIO_DT_SPEC_GET(DT_ALIAS(btn_up), gpios);
-const struct gpio_dt_spec btn_down =
-    GPIO_DT_SPEC_GET(DT_ALIAS(btn_down), gpios);
-const struct gpio_dt_spec btn_left =
-    GPIO_DT_SPEC_GET(DT_ALIAS(btn_left), gpios);
-const struct gpio_dt_spec btn_right =
-    GPIO_DT_SPEC_GET(DT_ALIAS(btn_right), gpios);
-const struct gpio_dt_spec btn_select =
-    GPIO_DT_SPEC_GET(DT_ALIAS(btn_select), gpios);
-const struct gpio_dt_spec btn_back =
-    GPIO_DT_SPEC_GET(DT_ALIAS(btn_back), gpios); // Using Back button
-
 /* LEDs */
 // Green, Blue or similar. I will use led0, led1, led2.
 const struct gpio_dt_spec led_red = GPIO_DT_SPEC_GET(DT_ALIAS(led_red), gpios);
@@ -50,79 +56,25 @@ const struct gpio_dt_spec led_blue =
 /* Buzzer */
 const struct gpio_dt_spec buzzer = GPIO_DT_SPEC_GET(DT_ALIAS(buzzer), gpios);
 
-/* Audio Helpers */
-static bool is_muted = false;
-void play_beep_move(void) {
-  if (is_muted)
-    return;
-  if (gpio_is_ready_dt(&buzzer)) {
-    for (int i = 0; i < 20; i++) {
-      gpio_pin_set_dt(&buzzer, 1);
-      k_usleep(250);
-      gpio_pin_set_dt(&buzzer, 0);
-      k_usleep(250);
-    }
-  }
-}
-void play_beep_eat(void) {
-  if (is_muted)
-    return;
-  if (gpio_is_ready_dt(&buzzer)) {
-    for (int i = 0; i < 50; i++) {
-      gpio_pin_set_dt(&buzzer, 1);
-      k_usleep(500 - (i * 5));
-      gpio_pin_set_dt(&buzzer, 0);
-      k_usleep(500 - (i * 5));
-    }
-  }
-}
-void play_beep_die(void) {
-  if (is_muted)
-    return;
-  if (gpio_is_ready_dt(&buzzer)) {
-    for (int i = 0; i < 100; i++) {
-      gpio_pin_set_dt(&buzzer, 1);
-      k_usleep(1000 + (i * 20));
-      gpio_pin_set_dt(&buzzer, 0);
-      k_usleep(1000 + (i * 20));
-    }
-  }
-}
-
 // --- Globals ---
 static App *current_app = NULL;
 static App *next_app = NULL;
-static bool menu_needs_redraw = true;
-
-// --- Mute Toggle App ---
-static char mute_app_name[20] = "Sound: ON";
-
-static void update_mute_label(void) {
-  if (is_muted) {
-    snprintf(mute_app_name, sizeof(mute_app_name), "Sound: OFF");
-  } else {
-    snprintf(mute_app_name, sizeof(mute_app_name), "Sound: ON");
-  }
-}
+static bool cold_start; // Switch restarts the app without its retained screen
 
-static void mute_app_enter(void) {
-  is_muted = !is_muted;
-  update_mute_label();
-  if (!is_muted) {
+// --- Mute Toggle (global chord; levels live in Settings > Sound) ---
+static void toggle_mute(void) {
+  audio_set_muted(!audio_muted());
+  audio_save_settings();
+  if (!audio_muted()) {
     play_beep_move();
   }
 }
 
-// Forward declaration of menu_app for return logic
-extern App menu_app;
-static void mute_app_return(void) { next_app = &menu_app; }
+// Hold SELECT, press BACK. SELECT reaches the app at once like any press;
+// the BACK press and what follows of both buttons until release do not.
+#define MUTE_CHORD (BIT(BTN_SELECT) | BIT(BTN_BACK))
 
-static void mute_app_exit(void) {}
-
-App mute_app = {.name = mute_app_name,
-                .enter = mute_app_enter,
-                .update = mute_app_return,
-                .exit = mute_app_exit};
+static uint8_t chord_swallowed; // Chord buttons the app sees no more of
 
 /* Menu App */
 /* Menu App Logic */
@@ -145,7 +97,7 @@ static App *apps_tools[] = {&i2c_scanner_app, &button_test_app,
 #define NUM_TOOLS 3
 
 // Settings
-static App *apps_settings[] = {&mute_app, &about_app, &shutdown_app};
+static App *apps_settings[] = {&sound_app, &about_app, &shutdown_app};
 #define NUM_SETTINGS 3
 
 // Root Categories
@@ -164,7 +116,8 @@ static int current_list_count = 0;
 static lv_obj_t *menu_list_cont;
 static lv_obj_t *arrow_up;
 static lv_obj_t *arrow_down;
-static lv_obj_t *menu_items[10]; // Max items viewable/cache
+static lv_obj_t *menu_items[10];    // Max items viewable/cache
+static int8_t menu_item_styled[10]; // Selected state styled, -1 = not yet
 
 static void update_menu_selection(void); // Forward Declaration
 
@@ -185,6 +138,7 @@ static void create_menu_item(lv_obj_t *parent, int index, const char *text) {
   lv_obj_set_style_text_font(label, &lv_font_montserrat_18, 0);
 
   menu_items[index] = cont;
+  menu_item_styled[index] = -1;
 }
 
 static int view_start = 0;
@@ -208,8 +162,14 @@ static void update_menu_selection(void) {
 
     // Calculate which data index this item represents
     int data_index = view_start + i;
+    bool selected = data_index == selected_index;
+
+    // Restyling redraws the row, leave the ones that stay as they are
+    if (menu_item_styled[i] == selected)
+      continue;
+    menu_item_styled[i] = selected;
 
-    if (data_index == selected_index) {
+    if (selected) {
       // Selected
       lv_obj_set_style_bg_color(cont, lv_color_black(), 0);
       lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, 0);
@@ -240,24 +200,18 @@ static void update_menu_selection(void) {
   }
 }
 
-// Rebuilds list with Viewport Logic
-static void rebuild_menu_list(void) {
-  if (!menu_list_cont)
-    return;
-
-  // Clear array
-  for (int i = 0; i < 10; i++)
-    menu_items[i] = NULL;
-  lv_obj_clean(menu_list_cont);
+static int menu_total_count(void) {
+  return (current_state == MENU_ROOT) ? NUM_CATEGORIES : current_list_count;
+}
 
-  int total_count = 0;
-  if (current_state == MENU_ROOT) {
-    total_count = NUM_CATEGORIES;
-  } else {
-    total_count = current_list_count;
-  }
+static const char *menu_item_text(int data_index) {
+  if (current_state == MENU_ROOT)
+    return category_names[data_index];
+  return current_app_list[data_index]->name;
+}
 
-  // Calculate View Start (Keep Selection Visible)
+// Calculate View Start (Keep Selection Visible)
+static void update_view_start(int total_count) {
   if (total_count <= MAX_VISIBLE_ITEMS) {
     view_start = 0;
   } else {
@@ -274,6 +228,20 @@ static void rebuild_menu_list(void) {
     if (view_start > total_count - MAX_VISIBLE_ITEMS)
       view_start = total_count - MAX_VISIBLE_ITEMS;
   }
+}
+
+// Rebuilds list with Viewport Logic (entering, or switching lists)
+static void rebuild_menu_list(void) {
+  if (!menu_list_cont)
+    return;
+
+  // Clear array
+  for (int i = 0; i < 10; i++)
+    menu_items[i] = NULL;
+  lv_obj_clean(menu_list_cont);
+
+  int total_count = menu_total_count();
+  update_view_start(total_count);
 
   // Determine Render List Count
   int render_count = total_count;
@@ -287,29 +255,34 @@ static void rebuild_menu_list(void) {
     if (data_index >= total_count)
       break;
 
-    const char *text = "";
-    if (current_state == MENU_ROOT) {
-      text = category_names[data_index];
-    } else {
-      text = current_app_list[data_index]->name;
-    }
-
-    create_menu_item(menu_list_cont, i, text);
+    create_menu_item(menu_list_cont, i, menu_item_text(data_index));
   }
 
   update_menu_selection();
 }
 
-static void menu_enter(void) {
+// Selection moved within the same list: restyle the rows in place, relabel
+// them only when the window scrolled, so a press is a small partial refresh
+static void scroll_menu_list(void) {
+  int old_start = view_start;
+
+  update_view_start(menu_total_count());
+  if (view_start != old_start) {
+    for (int i = 0; i < MAX_VISIBLE_ITEMS && menu_items[i]; i++)
+      lv_label_set_text(lv_obj_get_child(menu_items[i], 0),
+                        menu_item_text(view_start + i));
+  }
+  update_menu_selection();
+}
+
+static void menu_enter(lv_obj_t *scr) {
   LOG_INF("Entering Menu App. State: %d", current_state);
-  update_mute_label(); // Ensure label matches state
-  lv_obj_clean(lv_scr_act());
-  lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER,
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER,
                           0); // Ensure solid background
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
 
   // Main Flex Container - ROW Layout (Side-by-Side)
-  lv_obj_t *main_flex = lv_obj_create(lv_scr_act());
+  lv_obj_t *main_flex = lv_obj_create(scr);
   lv_obj_set_size(main_flex, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_border_width(main_flex, 0, 0);
   lv_obj_set_style_pad_all(main_flex, 0, 0);
@@ -410,60 +383,49 @@ static void menu_enter(void) {
     lv_obj_set_style_text_opa(arrow_down, LV_OPA_TRANSP, 0);
 
   rebuild_menu_list();
-  menu_needs_redraw = true;
 }
 
-static void menu_update(void) {
-
-  static int btn_up_prev = 0;
-  static int btn_right_prev = 0;
-  static int btn_back_prev = 0;
-  static int btn_left_prev = 0;
-  static int btn_down_prev = 0;
-  static int btn_select_prev = 0;
-
-  int btn_up_curr = gpio_pin_get_dt(&btn_up);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right); // Select
-  int btn_back_curr = gpio_pin_get_dt(&btn_back);
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_down_curr = gpio_pin_get_dt(&btn_down);
-  int btn_select_curr = gpio_pin_get_dt(&btn_select);
-
-  bool action_taken = false;
+static void menu_input(const ButtonEvent *evt) {
   int current_max =
       (current_state == MENU_ROOT) ? NUM_CATEGORIES : current_list_count;
 
+  // Only UP/DOWN scroll on hold, everything else acts on the press
+  bool scroll = evt->button == BTN_UP || evt->button == BTN_DOWN;
+  if (evt->action != BTN_PRESSED && !(scroll && evt->action == BTN_REPEAT))
+    return;
+
+  // A repeat can carry several steps, the list is rebuilt once for all
+  int steps = (evt->action == BTN_REPEAT) ? evt->steps : 1;
+
+  switch (evt->button) {
   // --- UP Button (Cycles Up/Wrap) ---
-  if (btn_up_curr && !btn_up_prev) {
+  case BTN_UP:
     LOG_INF("UP Pressed. Old Index: %d, Max: %d", selected_index, current_max);
-    selected_index--;
+    selected_index -= steps % current_max;
     if (selected_index < 0)
-      selected_index = current_max - 1; // Wrap to bottom
+      selected_index += current_max; // Wrap to bottom
     LOG_INF("New Index: %d", selected_index);
     play_beep_move();
 
-    // Force Rebuild to prevent ghosting/artifacts on E-Ink
-    rebuild_menu_list();
-    action_taken = true;
-  }
+    scroll_menu_list();
+    break;
 
   // --- DOWN Button (Cycles Down/Wrap) ---
-  if (btn_down_curr && !btn_down_prev) {
+  case BTN_DOWN:
     LOG_INF("DOWN Pressed. Old Index: %d, Max: %d", selected_index,
             current_max);
-    selected_index++;
+    selected_index += steps % current_max;
     if (selected_index >= current_max)
-      selected_index = 0; // Wrap to top
+      selected_index -= current_max; // Wrap to top
     LOG_INF("New Index: %d", selected_index);
     play_beep_move();
 
-    rebuild_menu_list();
-    action_taken = true;
-  }
+    scroll_menu_list();
+    break;
 
   // --- RIGHT Button (Select/Enter) ---
-  if ((btn_right_curr && !btn_right_prev) ||
-      (btn_select_curr && !btn_select_prev)) {
+  case BTN_RIGHT:
+  case BTN_SELECT:
     play_beep_eat();
     if (current_state == MENU_ROOT) {
       // ENTER SUBMENU
@@ -486,64 +448,143 @@ static void menu_update(void) {
       selected_index = 0; // Reset for submenu
       rebuild_menu_list();
     } else {
-      // Check for Special 'Actions' like Mute
-      if (current_app_list[selected_index] == &mute_app) {
-        is_muted = !is_muted;
-        update_mute_label();
-        if (!is_muted)
-          play_beep_move();
-        rebuild_menu_list(); // Refresh visuals immediately
-      } else {
-        // LAUNCH NORMAL APP
-        next_app = current_app_list[selected_index];
-      }
+      // LAUNCH APP
+      next_app = current_app_list[selected_index];
     }
-    action_taken = true;
-  }
+    break;
 
   // --- BACK Button (Return to Root) ---
   // Using actual Back button OR Left button
-  if ((btn_back_curr && !btn_back_prev) || (btn_left_curr && !btn_left_prev)) {
-    if (current_state == MENU_SUBMENU) {
-      play_beep_move();
-      current_state = MENU_ROOT;
-      selected_index = selected_category_index; // Restore position
-      rebuild_menu_list();
-      action_taken = true;
-    }
-  }
+  case BTN_BACK:
+  case BTN_LEFT:
+    if (current_state != MENU_SUBMENU)
+      return;
+    play_beep_move();
+    current_state = MENU_ROOT;
+    selected_index = selected_category_index; // Restore position
+    rebuild_menu_list();
+    break;
 
-  btn_up_prev = btn_up_curr;
-  btn_right_prev = btn_right_curr;
-  btn_back_prev = btn_back_curr;
-  btn_left_prev = btn_left_curr;
-  btn_down_prev = btn_down_curr;
-  btn_select_prev = btn_select_curr;
-
-  if (action_taken || menu_needs_redraw) {
-    menu_needs_redraw = false;
-    // update_menu_selection(); // Rebuild handles this now
-    // Invalidate the list container to ensure redraw
-    if (menu_list_cont)
-      lv_obj_invalidate(menu_list_cont);
+  default:
+    return;
   }
 }
 
+// Retained screen: rebuild the list for the current state
+static void menu_resume(void) { rebuild_menu_list(); }
+
 static void menu_exit(void) {}
 
 App menu_app = {.name = "Menu",
                 .enter = menu_enter,
-                .update = menu_update,
-                .exit = menu_exit};
+                .input = menu_input,
+                .exit = menu_exit,
+                .resume = menu_resume};
+
+/* App Transitions
+ * The outgoing screen is swapped for a bare stand-in (never drawn) while it
+ * is retained or torn down, then the incoming app builds (or resumes) its
+ * UI on its own screen, which is loaded in the same frame. Whether the
+ * switch goes out as a partial or a full refresh is up to the refresh
+ * manager (refresh.c): it cleans the panel when the switch would leave more
+ * ghosting than the incoming app's policy allows.
+ */
+static void switch_app(void) {
+  lv_obj_t *old_scr = lv_scr_act();
+  lv_obj_t *stand_in = lv_obj_create(NULL);
+
+  frame_stats_set_app(next_app);
+  frame_stats_launch_begin();
+
+  // Old screen is off the display now: keep it for later or tear it down
+  lv_scr_load(stand_in);
+  bool replayed = input_log_app_left();
+  screen_cache_close(current_app, old_scr);
+  if (replayed || cold_start)
+    screen_cache_discard(current_app);
+
+  current_app = next_app;
+  next_app = NULL;
+  if (cold_start) {
+    input_log_session_begin(current_app);
+    cold_start = false;
+  }
+
+  frame_stats_build_begin();
+  lv_obj_t *scr = screen_cache_open(current_app);
+  frame_stats_build_end();
+
+  refresh_set_app(current_app);
+  lv_scr_load(scr);
+  lv_obj_del(stand_in);
+
+  frame_stats_launch_shown();
+  input_log_app_shown();
+  buttons_flush(); // Presses made while switching are not replayed
+  chord_swallowed = 0;
+  buttons_set_timing(current_app->buttons);
+  event_loop_start_ticks(current_app);
+  request_update_in(0); // First update() right away
+}
+
+// Global chord: hold SELECT, press BACK to toggle sound anywhere. Returns
+// true if evt belongs to the chord and is not the app's.
+static bool mute_chord_filter(const ButtonEvent *evt) {
+  uint8_t bit = BIT(evt->button);
+
+  if (chord_swallowed & bit) {
+    if (evt->action == BTN_RELEASED)
+      chord_swallowed &= ~bit;
+    return true;
+  }
+  if (evt->button == BTN_BACK && evt->action == BTN_PRESSED &&
+      (evt->held & MUTE_CHORD) == MUTE_CHORD) {
+    chord_swallowed = MUTE_CHORD;
+    toggle_mute();
+    return true;
+  }
+  return false;
+}
+
+// Input first, so update() and ticks see this frame's presses
+static void run_app_frame(void) {
+  ButtonEvent evt;
+
+  frame_stats_update_begin();
+
+  while (!next_app && buttons_next_event(&evt)) {
+    frame_stats_input(&evt);
+    if (mute_chord_filter(&evt))
+      continue;
+
+    // Global Back Logic: BACK alone leaves every app except the menu
+    if (evt.button == BTN_BACK && evt.action == BTN_PRESSED &&
+        evt.held == BIT(BTN_BACK) && current_app != &menu_app) {
+      next_app = &menu_app;
+      break;
+    }
+    if (current_app->input)
+      current_app->input(&evt);
+  }
+
+  if (!next_app) {
+    if (current_app->update)
+      current_app->update();
+    event_loop_run_ticks(current_app);
+  }
+
+  frame_stats_update_end();
+}
 
 int main(void) {
   /* Init Drivers */
-  gpio_pin_configure_dt(&btn_up, GPIO_INPUT);
-  gpio_pin_configure_dt(&btn_down, GPIO_INPUT);
-  gpio_pin_configure_dt(&btn_left, GPIO_INPUT);
-  gpio_pin_configure_dt(&btn_right, GPIO_INPUT);
-  gpio_pin_configure_dt(&btn_select, GPIO_INPUT);
-  gpio_pin_configure_dt(&btn_back, GPIO_INPUT);
+#ifdef CONFIG_BADGE_BUTTON_DEBOUNCE
+  // Button lines and their interrupts (see debounce.c)
+  if (debounce_init() < 0)
+    LOG_ERR("Buttons unavailable");
+#else
+  // Buttons are owned by the gpio-keys input driver (see buttons.c)
+#endif
 
   // Outputs
   if (gpio_is_ready_dt(&led_red))
@@ -552,65 +593,60 @@ int main(void) {
     gpio_pin_configure_dt(&led_green, GPIO_OUTPUT_INACTIVE);
   if (gpio_is_ready_dt(&led_blue))
     gpio_pin_configure_dt(&led_blue, GPIO_OUTPUT_INACTIVE);
-  if (gpio_is_ready_dt(&buzzer))
-    gpio_pin_configure_dt(&buzzer, GPIO_OUTPUT_INACTIVE);
+  tone_init(); // Owns the buzzer pin
+#ifdef CONFIG_BADGE_MIXER
+  mixer_init(); // Shares it with the timer backend while a song plays
+#endif
+#ifdef CONFIG_SETTINGS
+  // Saved mute and volume levels (audio.c)
+  if (settings_subsys_init() == 0)
+    settings_load();
+#endif
+
+  frame_stats_init();
+  refresh_init();
+  image_1bpp_init(); // Before the first sprite is drawn
+  app_srand(sys_rand32_get()); // Record/replay sessions reseed
 
   current_app = &menu_app;
-  current_app->enter();
+  frame_stats_set_app(current_app);
+  refresh_set_app(current_app);
+  lv_obj_t *boot_scr = lv_scr_act();
+  lv_scr_load(screen_cache_open(current_app));
+  lv_obj_del(boot_scr);
+  event_loop_start_ticks(current_app);
 
   while (1) {
-    lv_task_handler();
-
-    // Global Back Logic (Debounced slightly)
-    static int64_t last_back_time = 0;
-    int64_t now_main = k_uptime_get();
-    if (gpio_pin_get_dt(&btn_back) && current_app != &menu_app) {
-      if (now_main - last_back_time > 300) {
-        next_app = &menu_app;
-        last_back_time = now_main;
-      }
-    }
-
-    if (next_app) {
-      if (current_app->exit) {
-        current_app->exit();
-      }
-
-      // IF returning to MENU, perform full E-Ink Clear (Black -> White)
-      // This removes ghosting from previous apps (especially dark ones like
-      // Snake/I2C)
-      if (next_app == &menu_app) {
-        // 1. Black
-        lv_obj_t *black_curtain = lv_obj_create(lv_scr_act());
-        lv_obj_set_size(black_curtain, LV_PCT(100), LV_PCT(100));
-        lv_obj_set_style_bg_color(black_curtain, lv_color_black(), 0);
-        lv_obj_set_style_bg_opa(black_curtain, LV_OPA_COVER, 0);
-        lv_obj_set_style_border_width(black_curtain, 0, 0);
-        lv_task_handler();    // Render Black
-        k_sleep(K_MSEC(100)); // Wait for E-Ink
-
-        // 2. White (Clear)
-        lv_obj_del(black_curtain);
-      }
+    // Replays run on a virtual clock and render every frame they run
+    bool replay = input_log_replaying();
+
+    // Render, then sleep until input, LVGL's next timer or an app deadline
+    frame_stats_render_begin();
+    refresh_poll(); // May render this frame as a full refresh
+    uint32_t lv_next = LV_NO_TIMER_READY;
+    if (replay)
+      lv_refr_now(NULL);
+    else
+      lv_next = lv_task_handler();
+    frame_stats_render_end();
 
-      // Always ensure clean slate
-      lv_obj_clean(lv_scr_act());
-      lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
-      lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
-      lv_task_handler(); // Render White
-      k_sleep(K_MSEC(50));
+    if (replay)
+      input_log_advance();
+    else
+      event_loop_wait(lv_next);
 
-      current_app = next_app;
-      next_app = NULL;
-      current_app->enter();
-    }
+    audio_poll(); // Effects asked for from the shell
 
-    // Fallback: If no next_app, just update current
-    if (current_app) {
-      current_app->update();
+    // Record/replay sessions restart the foreground app from scratch
+    if (input_log_poll(current_app == &menu_app ? NULL : current_app)) {
+      next_app = current_app;
+      cold_start = true;
+    } else {
+      run_app_frame();
     }
 
-    k_sleep(K_MSEC(10)); // Prevent CPU hogging
+    if (next_app)
+      switch_app();
   }
   return 0;
 }
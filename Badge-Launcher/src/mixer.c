@@ -0,0 +1,314 @@
+#include "mixer.h"
+
+#include <string.h>
+#include <zephyr/drivers/counter.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+#if defined(CONFIG_COUNTER) && DT_HAS_ALIAS(mixer_counter)
+#define USE_COUNTER 1
+static const struct device *const counter =
+    DEVICE_DT_GET(DT_ALIAS(mixer_counter));
+#endif
+
+#define FULL_SCALE (MIXER_CHANNELS * MIXER_MAX_VOLUME)
+#define NOISE_SPEEDUP 32 // Noise steps this many times per note period
+
+#define DUTY_SQUARE BIT(31)
+
+typedef struct {
+  uint32_t phase;
+  uint32_t step; // Phase increment per sample, 0 = silent
+  uint32_t duty; // Output is high while phase is below this
+  uint8_t volume;
+} Channel;
+
+typedef struct {
+  Channel ch[MIXER_CHANNELS];
+  uint16_t lfsr;     // 15-bit noise shift register
+  uint16_t sigma;    // Sigma-delta error, 0..FULL_SCALE
+  uint16_t arp_left; // Samples until the arpeggio moves on
+  uint8_t arp;       // Channel the arpeggio is sounding
+  uint8_t mode;
+} Synth;
+
+static Synth synth;
+static struct k_spinlock lock;
+static uint32_t rate;        // Actual sample rate, 0 = unavailable
+static uint64_t step_scale;  // Step = step_scale / period_ns
+static uint16_t arp_samples; // Samples per arpeggio slot
+
+static bool running;
+static bool level; // Buzzer level written last
+
+/* ISR cost, in hardware cycles */
+static uint32_t isr_max;
+static uint64_t isr_total;
+static uint32_t isr_count;
+
+static bool sounding(const Synth *s, int channel) {
+  return s->ch[channel].step && s->ch[channel].volume;
+}
+
+/*
+ * One output sample. Fixed work whatever is playing: MIXER_CHANNELS phase
+ * adds and duty compares, one LFSR step and either a sigma-delta step or,
+ * once per arpeggio slot, a scan of MIXER_CHANNELS channels.
+ */
+static bool synth_sample(Synth *s) {
+  uint32_t sum = 0;
+  uint32_t high = 0; // Channels whose output is high this sample
+
+  for (int i = 0; i < MIXER_VOICES; i++) {
+    Channel *ch = &s->ch[i];
+
+    ch->phase += ch->step;
+    if (ch->phase < ch->duty) {
+      sum += ch->volume;
+      high |= BIT(i);
+    }
+  }
+
+  Channel *noise = &s->ch[MIXER_NOISE];
+  uint32_t before = noise->phase;
+
+  noise->phase += noise->step;
+  if (noise->phase < before) {
+    uint16_t feedback = (s->lfsr ^ (s->lfsr >> 1)) & 1;
+    s->lfsr = (s->lfsr >> 1) | (feedback << 14);
+  }
+  if (noise->step && (s->lfsr & 1)) {
+    sum += noise->volume;
+    high |= BIT(MIXER_NOISE);
+  }
+
+  if (s->mode == MIXER_ARPEGGIO) {
+    if (--s->arp_left == 0) {
+      s->arp_left = arp_samples;
+      for (int i = 1; i <= MIXER_CHANNELS; i++) {
+        int next = (s->arp + i) % MIXER_CHANNELS;
+        if (sounding(s, next)) {
+          s->arp = next;
+          break;
+        }
+      }
+    }
+    return high & BIT(s->arp);
+  }
+
+  s->sigma += sum;
+  if (s->sigma >= FULL_SCALE) {
+    s->sigma -= FULL_SCALE;
+    return true;
+  }
+  return false;
+}
+
+static void render(void) {
+  uint32_t start = k_cycle_get_32();
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  bool out = synth_sample(&synth);
+  k_spin_unlock(&lock, key);
+
+  if (out != level) {
+    level = out;
+    gpio_pin_set_dt(&buzzer, out);
+  }
+
+  uint32_t cycles = k_cycle_get_32() - start;
+  isr_max = MAX(isr_max, cycles);
+  isr_total += cycles;
+  isr_count++;
+}
+
+#ifdef USE_COUNTER
+static void sample_fn(const struct device *dev, void *user_data) { render(); }
+
+static int timer_init(void) {
+  if (!device_is_ready(counter))
+    return -ENODEV;
+
+  uint32_t clock_hz = counter_get_frequency(counter);
+  struct counter_top_cfg top = {
+      .ticks = MAX(clock_hz / CONFIG_BADGE_MIXER_RATE, 1),
+      .callback = sample_fn,
+  };
+
+  rate = clock_hz / top.ticks;
+  return counter_set_top_value(counter, &top);
+}
+
+static void timer_start(void) { counter_start(counter); }
+static void timer_stop(void) { counter_stop(counter); }
+#else
+static void sample_fn(struct k_timer *timer) { render(); }
+K_TIMER_DEFINE(sample_timer, sample_fn, NULL);
+
+static uint32_t sample_ticks;
+
+static int timer_init(void) {
+  sample_ticks = CONFIG_SYS_CLOCK_TICKS_PER_SEC / CONFIG_BADGE_MIXER_RATE;
+  if (sample_ticks == 0)
+    return -ENOTSUP; // Tick rate below the sample rate
+  rate = CONFIG_SYS_CLOCK_TICKS_PER_SEC / sample_ticks;
+  return 0;
+}
+
+static void timer_start(void) {
+  k_timer_start(&sample_timer, K_TICKS(sample_ticks), K_TICKS(sample_ticks));
+}
+
+static void timer_stop(void) { k_timer_stop(&sample_timer); }
+#endif
+
+int mixer_init(void) {
+  int rc = gpio_is_ready_dt(&buzzer) ? timer_init() : -ENODEV;
+
+  if (rc < 0) {
+    LOG_ERR("Mixer unavailable (%d)", rc);
+    rate = 0;
+    return rc;
+  }
+  step_scale = (BIT64(32) * NSEC_PER_SEC) / rate;
+  arp_samples = MAX(rate / MIXER_ARP_HZ, 1);
+  synth.lfsr = 1;
+  synth.arp_left = arp_samples;
+  for (int i = 0; i < MIXER_VOICES; i++)
+    synth.ch[i].duty = DUTY_SQUARE;
+  return 0;
+}
+
+bool mixer_ready(void) { return rate != 0; }
+
+void mixer_start(void) {
+  if (!mixer_ready() || running)
+    return;
+  running = true;
+  timer_start();
+}
+
+void mixer_stop(void) {
+  if (!running)
+    return;
+  timer_stop();
+  running = false;
+
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  for (int i = 0; i < MIXER_CHANNELS; i++)
+    synth.ch[i] = (Channel){.duty = synth.ch[i].duty};
+  k_spin_unlock(&lock, key);
+  level = false;
+  gpio_pin_set_dt(&buzzer, 0);
+}
+
+static uint32_t period_to_step(int channel, uint32_t period_ns) {
+  if (period_ns == 0 || !mixer_ready())
+    return 0;
+
+  uint64_t step = step_scale / period_ns;
+  if (channel == MIXER_NOISE)
+    step *= NOISE_SPEEDUP;
+  return MIN(step, UINT32_MAX);
+}
+
+void mixer_set(int channel, uint32_t period_ns, uint8_t volume) {
+  if (channel < 0 || channel >= MIXER_CHANNELS)
+    return;
+
+  // The one division per note change, none per sample
+  uint32_t step = period_to_step(channel, period_ns);
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  Channel *ch = &synth.ch[channel];
+
+  if (step == 0)
+    ch->phase = 0; // A parked phase would hold its level as DC
+  ch->step = step;
+  ch->volume = MIN(volume, MIXER_MAX_VOLUME);
+  k_spin_unlock(&lock, key);
+}
+
+void mixer_set_duty(int channel, uint8_t percent) {
+  if (channel < 0 || channel >= MIXER_VOICES)
+    return;
+
+  uint32_t duty = (uint32_t)(BIT64(32) * MIN(percent, 100) / 100 - 1);
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  synth.ch[channel].duty = percent ? duty : 0;
+  k_spin_unlock(&lock, key);
+}
+
+void mixer_set_mode(MixerMode mode) {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  synth.mode = mode;
+  synth.sigma = 0;
+  k_spin_unlock(&lock, key);
+}
+
+/* Shell: badge mixer [pdm|arp|bench] */
+static uint64_t cycles_to_ns(uint64_t cycles) {
+  return cycles * NSEC_PER_SEC / sys_clock_hw_cycles_per_sec();
+}
+
+static void bench(const struct shell *sh, MixerMode mode) {
+  // Everything sounding: the most work a sample can do
+  Synth s = {.lfsr = 1, .arp_left = arp_samples, .mode = mode};
+  for (int i = 0; i < MIXER_CHANNELS; i++)
+    s.ch[i] = (Channel){.step = 0x01234567u * (i + 1),
+                        .duty = DUTY_SQUARE,
+                        .volume = 15};
+
+  uint32_t samples = rate; // One second of audio
+  uint32_t sink = 0;
+  uint64_t start = k_cycle_get_64();
+  for (uint32_t i = 0; i < samples; i++)
+    sink += synth_sample(&s);
+  uint64_t cycles = k_cycle_get_64() - start;
+
+  uint32_t ns = cycles_to_ns(cycles) / samples;
+  shell_print(sh, "  %-3s %u ns/sample, %u%% of the sample period (%u high)",
+              mode == MIXER_PDM ? "pdm" : "arp", ns,
+              (uint32_t)((uint64_t)ns * rate / (NSEC_PER_SEC / 100)), sink);
+}
+
+static int cmd_mixer(const struct shell *sh, size_t argc, char **argv) {
+  if (!mixer_ready()) {
+    shell_error(sh, "Mixer unavailable");
+    return -ENODEV;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "pdm") == 0) {
+      mixer_set_mode(MIXER_PDM);
+    } else if (strcmp(argv[1], "arp") == 0) {
+      mixer_set_mode(MIXER_ARPEGGIO);
+    } else if (strcmp(argv[1], "bench") == 0) {
+      shell_print(sh, "Synthesis cost at %u Hz, all channels sounding:",
+                  rate);
+      bench(sh, MIXER_PDM);
+      bench(sh, MIXER_ARPEGGIO);
+      return 0;
+    } else {
+      shell_error(sh, "Usage: badge mixer [pdm|arp|bench]");
+      return -EINVAL;
+    }
+  }
+
+  shell_print(sh, "Mixer: %u Hz, %s, %s", rate,
+              synth.mode == MIXER_PDM ? "pulse density" : "arpeggio",
+              running ? "running" : "idle");
+  for (int i = 0; i < MIXER_CHANNELS; i++)
+    shell_print(sh, "  %s %d: step %08x duty %08x volume %u",
+                i == MIXER_NOISE ? "noise" : "pulse", i, synth.ch[i].step,
+                synth.ch[i].duty, synth.ch[i].volume);
+  if (isr_count)
+    shell_print(sh, "ISR: avg %u ns, max %u ns, budget %u ns per sample",
+                (uint32_t)cycles_to_ns(isr_total / isr_count),
+                (uint32_t)cycles_to_ns(isr_max), NSEC_PER_SEC / rate);
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), mixer, NULL,
+                 "Chiptune mixer state, ISR cost and mode\n"
+                 "Usage: badge mixer [pdm|arp|bench]",
+                 cmd_mixer, 1, 1);
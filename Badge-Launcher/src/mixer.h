@@ -0,0 +1,47 @@
+#ifndef MIXER_H
+#define MIXER_H
+
+#include "app_shared.h"
+
+/*
+ * Chiptune mixer (CONFIG_BADGE_MIXER). A sample interrupt at
+ * CONFIG_BADGE_MIXER_RATE runs MIXER_VOICES pulse-wave phase accumulators
+ * (three for music, MIXER_SFX for sound effects) and an LFSR noise
+ * channel, sums their volumes and turns the sum into a 1-bit buzzer level
+ * with a first-order sigma-delta modulator (pulse density). In arpeggio
+ * mode the output instead cycles through the sounding channels every
+ * MIXER_ARP_HZ, one at full level, the classic way to fake chords on one
+ * pin. The sample rate comes from a mixer-counter devicetree alias, or
+ * else from the kernel timer, which needs CONFIG_SYS_CLOCK_TICKS_PER_SEC
+ * of at least the rate. "badge mixer" shows the ISR cost against its
+ * budget.
+ */
+#define MIXER_VOICES 4
+#define MIXER_SFX 3              // Pulse channel the audio thread's effects use
+#define MIXER_NOISE MIXER_VOICES // Channel number of the noise channel
+#define MIXER_CHANNELS (MIXER_VOICES + 1)
+#define MIXER_MAX_VOLUME 15
+#define MIXER_ARP_HZ 60
+
+typedef enum { MIXER_PDM, MIXER_ARPEGGIO } MixerMode;
+
+/* Sets up the sample timer, called once at boot */
+int mixer_init(void);
+bool mixer_ready(void);
+
+/* The sample interrupt only runs between start and stop */
+void mixer_start(void);
+void mixer_stop(void);
+
+/*
+ * Sounds a channel at the given period (0 = silent) and volume. For the
+ * noise channel the period sets how often the noise generator steps.
+ */
+void mixer_set(int channel, uint32_t period_ns, uint8_t volume);
+
+/* High part of a pulse channel's wave in percent, 50 (square) by default */
+void mixer_set_duty(int channel, uint8_t percent);
+
+void mixer_set_mode(MixerMode mode);
+
+#endif
@@ -0,0 +1,397 @@
+#include "music.h"
+#include "audio.h"
+#include "mixer.h"
+#include "song.h"
+#include "tone.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+#define VOICE_VOLUME 12
+#define DRUM_VOLUME 8
+#define RELEASE_MS 15    // Silence at the end of a note, so repeats re-strike
+#define BUSY_CHUNK_MS 20 // Busy-loop tones play this long between checks
+
+/* Everything below is shared by the caller's thread and the audio thread */
+static K_MUTEX_DEFINE(lock);
+
+static MusicState state;
+static int song_index = -1;
+static const Song *song;
+static uint32_t length_ms;
+static int64_t started;    // Uptime at song time 0, while playing
+static uint32_t paused_at; // Song time, while paused
+static bool use_mixer;     // Fixed per song when it starts
+
+/* Sequencer, one entry per track, times in song ms */
+static SongCursor cursor[SONG_MAX_TRACKS];
+static uint32_t due[SONG_MAX_TRACKS];     // Next note starts
+static uint32_t release[SONG_MAX_TRACKS]; // Sounding note lets go
+static uint32_t period[SONG_MAX_TRACKS];  // Note in progress, 0 = rest
+static bool ended[SONG_MAX_TRACKS];
+
+/* Outputs as last written, for the audio thread */
+static uint32_t out[SONG_MAX_TRACKS];
+static uint8_t out_gain; // Percent of full volume they were written at
+static bool sounding;     // Outputs are ours (not silenced or cut by an effect)
+static bool restart;      // A new song started, clear the old one's outputs
+
+static int tracks(void) {
+  return song ? MIN(song->tracks, use_mixer ? SONG_MAX_TRACKS : 1) : 0;
+}
+
+// Processes every note event up to pos; no output, so seeking is cheap
+static void advance(uint32_t pos) {
+  for (int t = 0; t < tracks(); t++) {
+    SongNote note;
+
+    while (!ended[t] && due[t] <= pos) {
+      if (!song_next(&cursor[t], &note)) {
+        ended[t] = true;
+        period[t] = 0;
+        break;
+      }
+      period[t] = note.period_ns;
+      release[t] = due[t] + note.ms - MIN(RELEASE_MS, note.ms / 2);
+      due[t] += note.ms; // Stepping from the last due time never drifts
+    }
+  }
+}
+
+static void restart_tracks(void) {
+  for (int t = 0; t < tracks(); t++) {
+    song_begin(&cursor[t], song, t);
+    due[t] = release[t] = period[t] = 0;
+    ended[t] = false;
+  }
+}
+
+static uint32_t song_length(const Song *s) {
+  uint32_t longest = 0;
+
+  for (int t = 0; t < s->tracks; t++) {
+    SongCursor c;
+    SongNote note;
+    uint32_t ms = 0;
+
+    song_begin(&c, s, t);
+    while (song_next(&c, &note))
+      ms += note.ms;
+    longest = MAX(longest, ms);
+  }
+  return longest;
+}
+
+static uint32_t position(int64_t now) {
+  if (state == MUSIC_PAUSED)
+    return paused_at;
+  return MIN((uint32_t)(now - started), length_ms);
+}
+
+static bool mixer_available(void) {
+#ifdef CONFIG_BADGE_MIXER
+  return mixer_ready();
+#else
+  return false;
+#endif
+}
+
+static void start_song(int index, int64_t now) {
+  song_index = index;
+  song = &songs[index];
+  use_mixer = mixer_available();
+  length_ms = song_length(song);
+  started = now;
+  state = MUSIC_PLAYING;
+  restart = true;
+  restart_tracks();
+}
+
+void music_play(int index) {
+  if (index < 0 || index >= song_count)
+    return;
+  k_mutex_lock(&lock, K_FOREVER);
+  start_song(index, k_uptime_get());
+  k_mutex_unlock(&lock);
+  audio_wake();
+}
+
+void music_stop(void) {
+  k_mutex_lock(&lock, K_FOREVER);
+  state = MUSIC_STOPPED;
+  song_index = -1;
+  k_mutex_unlock(&lock);
+  audio_wake();
+}
+
+void music_pause(bool paused) {
+  int64_t now = k_uptime_get();
+
+  k_mutex_lock(&lock, K_FOREVER);
+  if (paused && state == MUSIC_PLAYING) {
+    paused_at = position(now);
+    state = MUSIC_PAUSED;
+  } else if (!paused && state == MUSIC_PAUSED) {
+    started = now - paused_at;
+    state = MUSIC_PLAYING;
+  }
+  k_mutex_unlock(&lock);
+  audio_wake();
+}
+
+void music_seek(uint32_t position_ms) {
+  int64_t now = k_uptime_get();
+
+  k_mutex_lock(&lock, K_FOREVER);
+  if (state != MUSIC_STOPPED) {
+    position_ms = MIN(position_ms, length_ms);
+    restart_tracks();
+    advance(position_ms);
+    started = now - position_ms;
+    paused_at = position_ms;
+  }
+  k_mutex_unlock(&lock);
+  audio_wake();
+}
+
+void music_get_status(MusicStatus *status) {
+  k_mutex_lock(&lock, K_FOREVER);
+  *status = (MusicStatus){
+      .state = state,
+      .song = song_index,
+      .position_ms = state == MUSIC_STOPPED ? 0 : position(k_uptime_get()),
+      .length_ms = state == MUSIC_STOPPED ? 0 : length_ms,
+  };
+  k_mutex_unlock(&lock);
+}
+
+/* Audio thread */
+static void output(int track, uint32_t period_ns) {
+  if (use_mixer) {
+#ifdef CONFIG_BADGE_MIXER
+    bool drum = track == song->noise_track;
+    // convert_songs.py puts the noise track after the melodic ones
+    uint32_t volume = drum ? DRUM_VOLUME : VOICE_VOLUME;
+    mixer_set(drum ? MIXER_NOISE : track, period_ns,
+              period_ns ? DIV_ROUND_UP(volume * out_gain, 100) : 0);
+    if (track == 0)
+      tone_probe_note(period_ns); // Onsets only, the mixer has no edges
+#endif
+  } else {
+    tone_set_gain(out_gain);
+    tone_start_ns(period_ns);
+  }
+  out[track] = period_ns;
+}
+
+// Frees the buzzer; on the mixer only the music channels, effects go on
+static void silence(void) {
+  if (!sounding)
+    return;
+#ifdef CONFIG_BADGE_MIXER
+  if (use_mixer) {
+    for (int ch = 0; ch < MIXER_CHANNELS; ch++)
+      if (ch != MIXER_SFX)
+        mixer_set(ch, 0, 0);
+  } else
+#endif
+    tone_stop();
+  sounding = false;
+}
+
+int32_t music_service(uint8_t gain) {
+  int64_t now = k_uptime_get();
+  uint32_t wait = UINT32_MAX;
+
+  k_mutex_lock(&lock, K_FOREVER);
+  if (restart) {
+    silence(); // The last song may have used channels this one does not
+    restart = false;
+  }
+
+  if (state == MUSIC_PLAYING) {
+    uint32_t pos = position(now);
+
+    advance(pos);
+    for (int t = 0; t < tracks(); t++) {
+      if (!ended[t])
+        wait = MIN(wait, due[t] - pos);
+      if (pos < release[t])
+        wait = MIN(wait, release[t] - pos);
+    }
+
+    if (pos >= length_ms) {
+      // Next song, or stop after the last one
+      if (song_index + 1 < song_count) {
+        start_song(song_index + 1, now);
+        silence();
+        restart = false;
+        wait = 0;
+      } else {
+        state = MUSIC_STOPPED;
+        song_index = -1;
+      }
+    } else {
+      wait = MIN(wait, length_ms - pos); // Tracks left unplayed
+    }
+  }
+
+  if (state != MUSIC_PLAYING || gain == 0) {
+    silence();
+    k_mutex_unlock(&lock);
+    return state == MUSIC_PLAYING ? wait : SYS_FOREVER_MS;
+  }
+
+  uint32_t pos = position(now);
+  // Re-sound everything after a cut or a volume change
+  bool refresh = !sounding || gain != out_gain;
+#ifdef CONFIG_BADGE_MIXER
+  if (refresh && use_mixer)
+    mixer_start();
+#endif
+  sounding = true;
+  out_gain = gain;
+
+  for (int t = 0; t < tracks(); t++) {
+    uint32_t want = pos < release[t] ? period[t] : 0;
+    if (refresh || want != out[t])
+      output(t, want);
+  }
+  uint32_t busy_ns = use_mixer ? 0 : out[0];
+  k_mutex_unlock(&lock);
+
+#ifdef CONFIG_BADGE_TONE_BUSY
+  // The busy backend only sounds while a thread plays it
+  if (busy_ns) {
+    tone_set_gain(gain);
+    tone_play_ns(busy_ns, MIN(wait, BUSY_CHUNK_MS) * 1000);
+    return 0;
+  }
+#else
+  ARG_UNUSED(busy_ns);
+#endif
+  return wait;
+}
+
+/* Shell: badge music bench [n] */
+static void bench_song(const struct shell *sh, int index) {
+  MusicStatus st;
+  ToneProbeStats probe;
+
+  tone_probe_arm();
+  music_play(index);
+  do {
+    k_msleep(50);
+    music_get_status(&st);
+  } while (st.state == MUSIC_PLAYING && st.song == index);
+  music_stop();
+  tone_probe_disarm(&probe);
+
+  // Onsets against the first track's note starts, relative to the first
+  const uint32_t *onsets = tone_probe_onsets();
+  SongCursor c;
+  SongNote note;
+  uint32_t at_ms = 0, prev_ms = 0;
+  uint32_t jitter_max = 0;
+  uint64_t jitter_sum = 0;
+  int32_t drift_us = 0;
+  int n = 0;
+
+  song_begin(&c, &songs[index], 0);
+  while (song_next(&c, &note)) {
+    if (note.period_ns && n < probe.notes) {
+      if (n > 0) {
+        int64_t got = k_cyc_to_us_near64(onsets[n] - onsets[n - 1]);
+        uint32_t off = llabs(got - (int64_t)(at_ms - prev_ms) * 1000);
+        jitter_max = MAX(jitter_max, off);
+        jitter_sum += off;
+        drift_us = k_cyc_to_us_near64(onsets[n] - onsets[0]) -
+                   (int64_t)at_ms * 1000;
+      }
+      prev_ms = at_ms;
+      n++;
+    }
+    at_ms += note.ms;
+  }
+
+  shell_print(sh, "%s: %d onsets, %u notes with edges", songs[index].title,
+              n, probe.measured);
+  if (probe.measured)
+    shell_print(sh, "  pitch off avg %u max %u ppm, duty off avg %u max %u ppm",
+                probe.pitch_avg_ppm, probe.pitch_max_ppm, probe.duty_avg_ppm,
+                probe.duty_max_ppm);
+  if (n > 1)
+    shell_print(sh, "  onset jitter avg %u max %u us, drift at end %d us",
+                (uint32_t)(jitter_sum / (n - 1)), jitter_max, drift_us);
+}
+
+static int cmd_bench(const struct shell *sh, size_t argc, char **argv) {
+  int from = 0, to = song_count;
+
+  if (argc > 2) {
+    from = strtoul(argv[2], NULL, 0) - 1;
+    to = from + 1;
+    if (from < 0 || from >= song_count)
+      return -EINVAL;
+  }
+  if (audio_muted()) {
+    shell_error(sh, "Sound is muted");
+    return -EPERM;
+  }
+
+  shell_print(sh, "Timing songs on the %s (this plays them in full)",
+              mixer_available() ? "mixer" : tone_backend_name);
+  for (int i = from; i < to; i++)
+    bench_song(sh, i);
+  return 0;
+}
+
+/* Shell: badge music [play <n>|stop|pause|resume|seek <s>] */
+static int cmd_music(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    uint32_t arg = argc > 2 ? strtoul(argv[2], NULL, 0) : 0;
+
+    if (strcmp(argv[1], "play") == 0 && arg >= 1 && arg <= song_count) {
+      music_play(arg - 1);
+    } else if (strcmp(argv[1], "stop") == 0) {
+      music_stop();
+    } else if (strcmp(argv[1], "pause") == 0) {
+      music_pause(true);
+    } else if (strcmp(argv[1], "resume") == 0) {
+      music_pause(false);
+    } else if (strcmp(argv[1], "seek") == 0 && argc > 2) {
+      music_seek(arg * 1000);
+    } else if (strcmp(argv[1], "bench") == 0) {
+      return cmd_bench(sh, argc, argv);
+    } else {
+      shell_error(sh, "Usage: badge music [play <1-%d>|stop|pause|resume|"
+                      "seek <s>|bench [n]]",
+                  song_count);
+      return -EINVAL;
+    }
+  }
+
+  MusicStatus st;
+  static const char *const names[] = {"stopped", "playing", "paused"};
+
+  music_get_status(&st);
+  if (st.state == MUSIC_STOPPED) {
+    shell_print(sh, "Music: stopped");
+    return 0;
+  }
+  shell_print(sh, "Music: %s %d/%d \"%s\" %u.%03u/%u.%03u s on %s",
+              names[st.state], st.song + 1, song_count, songs[st.song].title,
+              st.position_ms / 1000, st.position_ms % 1000,
+              st.length_ms / 1000, st.length_ms % 1000,
+              use_mixer ? "mixer" : "tone");
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), music, NULL,
+                 "Background music state and control\n"
+                 "Usage: badge music [play <n>|stop|pause|resume|seek <s>|"
+                 "bench [n]]",
+                 cmd_music, 1, 2);
@@ -0,0 +1,39 @@
+#ifndef MUSIC_H
+#define MUSIC_H
+
+#include "app_shared.h"
+
+/*
+ * Background music. Songs (song.h) are sequenced by the audio thread, so
+ * playback carries on while apps run and while the launcher is in the
+ * menu. With CONFIG_BADGE_MIXER every track sounds on its own mixer
+ * channel and sound effects mix in over it, otherwise the first track
+ * plays on the tone backend and effects cut in. Mute silences it and the
+ * music level (audio.h) scales it; the song clock keeps running either
+ * way. At the end of a song the next one starts, after the last one
+ * playback stops.
+ */
+typedef enum { MUSIC_STOPPED, MUSIC_PLAYING, MUSIC_PAUSED } MusicState;
+
+typedef struct {
+  MusicState state;
+  int song;             // Index into songs[], -1 when stopped
+  uint32_t position_ms; // Song time
+  uint32_t length_ms;   // Longest track
+} MusicStatus;
+
+void music_play(int song);
+void music_stop(void);
+void music_pause(bool paused);
+void music_seek(uint32_t position_ms); // Clamped to the song length
+void music_get_status(MusicStatus *status);
+
+/*
+ * Audio thread side: catches the sequencer up to now and drives the
+ * outputs at gain percent of full volume, or keeps them quiet at 0 (muted,
+ * or an effect has the tone backend). Returns how long it can sleep,
+ * SYS_FOREVER_MS when nothing is playing.
+ */
+int32_t music_service(uint8_t gain);
+
+#endif
@@ -0,0 +1,190 @@
+#include "piano_roll.h"
+#include "frame_stats.h"
+#include "song.h"
+
+#include <string.h>
+
+#define COLUMNS (PIANO_ROLL_WIDTH / 8)
+#define STRIDE COLUMNS // Bytes per row, LVGL's default stride alignment
+#define PALETTE_SIZE 8 // Two 32-bit entries ahead of the pixels
+#define SLICE_MS 125   // Song time per column
+#define MIN_STEP_MS 250
+#define MAX_STEP_MS 1000
+
+#define NOTE_BYTE 0xfe // A dash with a 1 px gap before the next column
+#define DRUM_BYTE 0x18
+#define NOTE_ROWS (PIANO_ROLL_HEIGHT - 4) // Top rows of a dash, drums below
+
+static uint8_t buf[PALETTE_SIZE + STRIDE * PIANO_ROLL_HEIGHT] __aligned(4);
+static uint8_t *const pixels = buf + PALETTE_SIZE;
+static lv_obj_t *canvas;
+
+/* Decoder state for the next column to come into view */
+typedef struct {
+  SongCursor cursor;
+  uint32_t end_ms;    // Song time the current note ends
+  uint32_t period_ns; // Current note, 0 = rest
+  bool ended;
+} RollTrack;
+
+static RollTrack tracks[SONG_MAX_TRACKS];
+static int shown_song = -1;
+static uint32_t base_ms; // Song time of the leftmost column
+static uint32_t next_ms; // Song time of the next column to decode
+static int64_t last_step;
+
+/* Note range of the song, for the row scale */
+static uint8_t note_lo;
+static uint8_t note_hi;
+
+static int period_to_note(uint32_t period_ns) {
+  // song_period_ns[] falls as the note rises
+  int lo = 0, hi = song_note_hi - song_note_lo;
+
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (song_period_ns[mid] > period_ns)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return song_note_lo + lo;
+}
+
+static void rewind_tracks(const Song *song) {
+  for (int t = 0; t < song->tracks; t++) {
+    song_begin(&tracks[t].cursor, song, t);
+    tracks[t].end_ms = 0;
+    tracks[t].period_ns = 0;
+    tracks[t].ended = false;
+  }
+}
+
+static void scan_range(const Song *song) {
+  note_lo = song_note_hi;
+  note_hi = song_note_lo;
+  for (int t = 0; t < song->tracks; t++) {
+    SongCursor c;
+    SongNote note;
+
+    if (t == song->noise_track)
+      continue;
+    song_begin(&c, song, t);
+    while (song_next(&c, &note)) {
+      if (note.period_ns) {
+        int n = period_to_note(note.period_ns);
+        note_lo = MIN(note_lo, n);
+        note_hi = MAX(note_hi, n);
+      }
+    }
+  }
+}
+
+// Decodes the column at next_ms into x, then moves on a slice
+static void draw_column(const Song *song, int x) {
+  for (int y = 0; y < PIANO_ROLL_HEIGHT; y++)
+    pixels[y * STRIDE + x] = 0;
+
+  for (int t = 0; t < song->tracks; t++) {
+    RollTrack *tr = &tracks[t];
+    SongNote note;
+
+    while (!tr->ended && tr->end_ms <= next_ms) {
+      if (song_next(&tr->cursor, &note)) {
+        tr->period_ns = note.period_ns;
+        tr->end_ms += note.ms;
+      } else {
+        tr->ended = true;
+        tr->period_ns = 0;
+      }
+    }
+    if (!tr->period_ns)
+      continue;
+
+    if (t == song->noise_track) {
+      pixels[(PIANO_ROLL_HEIGHT - 1) * STRIDE + x] |= DRUM_BYTE;
+    } else {
+      int span = MAX(note_hi - note_lo, 1);
+      int n = period_to_note(tr->period_ns) - note_lo;
+      int y = (NOTE_ROWS - 2) - n * (NOTE_ROWS - 2) / span;
+
+      pixels[y * STRIDE + x] |= NOTE_BYTE;
+      pixels[(y + 1) * STRIDE + x] |= NOTE_BYTE;
+    }
+  }
+  next_ms += SLICE_MS;
+}
+
+static void redraw(int song, uint32_t pos_ms) {
+  const Song *s = &songs[song];
+
+  if (song != shown_song) {
+    scan_range(s);
+    shown_song = song;
+  }
+  rewind_tracks(s);
+  base_ms = next_ms = pos_ms - pos_ms % SLICE_MS;
+  for (int x = 0; x < COLUMNS; x++)
+    draw_column(s, x);
+}
+
+// Moves the view on by whole columns, decoding only the new ones
+static void scroll(int columns) {
+  const Song *s = &songs[shown_song];
+
+  for (int y = 0; y < PIANO_ROLL_HEIGHT; y++)
+    memmove(&pixels[y * STRIDE], &pixels[y * STRIDE + columns],
+            COLUMNS - columns);
+  for (int x = COLUMNS - columns; x < COLUMNS; x++)
+    draw_column(s, x);
+  base_ms += columns * SLICE_MS;
+}
+
+static void changed(void) {
+  // The canvas image may be cached decoded, drop it before redrawing
+  lv_image_cache_drop(lv_canvas_get_draw_buf(canvas));
+  lv_obj_invalidate(canvas);
+}
+
+lv_obj_t *piano_roll_create(lv_obj_t *parent) {
+  canvas = lv_canvas_create(parent);
+  lv_canvas_set_buffer(canvas, buf, PIANO_ROLL_WIDTH, PIANO_ROLL_HEIGHT,
+                       LV_COLOR_FORMAT_I1);
+  lv_canvas_set_palette(canvas, 0, lv_color_to_32(lv_color_white(), 0xff));
+  lv_canvas_set_palette(canvas, 1, lv_color_to_32(lv_color_black(), 0xff));
+  memset(pixels, 0, STRIDE * PIANO_ROLL_HEIGHT);
+  shown_song = -1;
+  return canvas;
+}
+
+uint32_t piano_roll_update(const MusicStatus *st) {
+  if (st->state == MUSIC_STOPPED) {
+    if (shown_song >= 0) {
+      memset(pixels, 0, STRIDE * PIANO_ROLL_HEIGHT);
+      shown_song = -1;
+      changed();
+    }
+    return 0;
+  }
+
+  // Catch up at most every other panel refresh, e-ink cannot keep up
+  int64_t now = k_uptime_get();
+  uint32_t step_ms = CLAMP(2 * frame_stats_last_flush_us() / 1000,
+                           MIN_STEP_MS, MAX_STEP_MS);
+  bool moved = st->song != shown_song || st->position_ms < base_ms;
+
+  if (!moved && now - last_step < step_ms)
+    return st->state == MUSIC_PLAYING ? step_ms - (now - last_step) : 0;
+
+  uint32_t columns = (st->position_ms - base_ms) / SLICE_MS;
+  if (moved || columns >= COLUMNS)
+    redraw(st->song, st->position_ms); // New song, seek or a long stall
+  else if (columns)
+    scroll(columns);
+  else
+    return st->state == MUSIC_PLAYING ? SLICE_MS : 0;
+
+  changed();
+  last_step = now;
+  return st->state == MUSIC_PLAYING ? step_ms : 0;
+}
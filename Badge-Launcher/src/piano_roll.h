@@ -0,0 +1,22 @@
+#ifndef PIANO_ROLL_H
+#define PIANO_ROLL_H
+
+#include "app_shared.h"
+#include "music.h"
+
+/*
+ * Scrolling piano roll of the song playing, for Chip Tunez. The strip is a
+ * 1-bpp canvas with one byte per column and row, so scrolling is a memmove
+ * per row and only the columns that came into view are decoded, with their
+ * own song cursors: the audio thread is never touched. Redraws are paced to
+ * at least twice the panel's last refresh time.
+ */
+#define PIANO_ROLL_WIDTH 296 // 37 columns of 8 px
+#define PIANO_ROLL_HEIGHT 32
+
+lv_obj_t *piano_roll_create(lv_obj_t *parent);
+
+/* Catches up with st; returns ms until it wants to run again, 0 = idle */
+uint32_t piano_roll_update(const MusicStatus *st);
+
+#endif
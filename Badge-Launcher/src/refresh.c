@@ -0,0 +1,276 @@
+#include "refresh.h"
+
+#include <string.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+/* Damage is kept per region of a 4x3 split of the panel */
+#define REGION_COLS 4
+#define REGION_ROWS 3
+#define SWITCH_DAMAGE 4 // A whole new screen leaves more ghost than an update
+#define LOG_SIZE 8
+
+typedef struct {
+  const char *name;
+  uint16_t budget;   // Partial refreshes a region takes, 0 = always full
+  uint16_t idle_ms;  // Still screen before leftover damage is cleaned
+  uint16_t idle_min; // Damage worth an idle clean
+} PolicyDef;
+
+static const PolicyDef policies[] = {
+    [REFRESH_BALANCED] = {"balanced", 24, 5000, 6},
+    [REFRESH_FAST] = {"fast", 300, 3000, 20},
+    [REFRESH_QUALITY] = {"quality", 0, 0, 1},
+};
+
+typedef enum {
+  CLEAN_BOOT,
+  CLEAN_POLICY, // Quality app changed its screen
+  CLEAN_BUDGET,
+  CLEAN_SWITCH, // Budget ran out on an app switch
+  CLEAN_IDLE,
+  CLEAN_SHELL,
+  CLEAN_REASONS
+} CleanReason;
+
+static const char *const reason_names[] = {"boot",   "policy", "budget",
+                                           "switch", "idle",   "shell"};
+
+typedef struct {
+  int64_t uptime_ms;
+  const App *app;
+  uint8_t reason; // CleanReason
+  uint16_t worst; // Most damaged region before the clean
+} Decision;
+
+static const struct device *const display =
+    DEVICE_DT_GET_OR_NULL(DT_CHOSEN(zephyr_display));
+
+static const App *current;
+static uint16_t damage[REGION_ROWS][REGION_COLS];
+static int32_t region_w = 1;
+static int32_t region_h = 1;
+static bool changed;  // Invalidated, not flushed yet
+static bool switched; // New screen loaded, not flushed yet
+static bool cleaning; // Flushes belong to a full refresh
+static int64_t last_change;
+
+/* Stats */
+static uint32_t partials;
+static uint32_t cleans[CLEAN_REASONS];
+static uint32_t wipes; // Cleans done without display blanking
+static Decision decisions[LOG_SIZE];
+static uint32_t num_decisions;
+
+/* Requested from the shell thread, applied on the next poll */
+static atomic_t clean_pending;
+static atomic_t reset_pending;
+static atomic_t policy_override; // 0 = the app's, else RefreshPolicy + 1
+
+static RefreshPolicy current_policy(void) {
+  atomic_val_t forced = atomic_get(&policy_override);
+
+  if (forced)
+    return forced - 1;
+  return current ? current->refresh : REFRESH_BALANCED;
+}
+
+static uint16_t worst_damage(void) {
+  uint16_t worst = 0;
+
+  for (int y = 0; y < REGION_ROWS; y++)
+    for (int x = 0; x < REGION_COLS; x++)
+      worst = MAX(worst, damage[y][x]);
+  return worst;
+}
+
+static void add_damage(int x1, int y1, int x2, int y2, uint16_t amount) {
+  for (int y = y1; y <= y2; y++) {
+    for (int x = x1; x <= x2; x++)
+      damage[y][x] = MIN(damage[y][x] + amount, UINT16_MAX);
+  }
+}
+
+static void display_event_cb(lv_event_t *e) {
+  const lv_area_t *area = lv_event_get_param(e);
+
+  if (cleaning || !area)
+    return;
+
+  if (lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA) {
+    changed = true;
+    last_change = k_uptime_get();
+    return;
+  }
+
+  // LV_EVENT_FLUSH_FINISH: a partial refresh over these regions
+  partials++;
+  changed = false;
+  switched = false;
+  add_damage(CLAMP(area->x1 / region_w, 0, REGION_COLS - 1),
+             CLAMP(area->y1 / region_h, 0, REGION_ROWS - 1),
+             CLAMP(area->x2 / region_w, 0, REGION_COLS - 1),
+             CLAMP(area->y2 / region_h, 0, REGION_ROWS - 1), 1);
+}
+
+// Black, then white over the whole panel, then the screen again
+static void wipe(void) {
+  lv_obj_t *cover = lv_obj_create(lv_layer_top());
+
+  lv_obj_remove_style_all(cover);
+  lv_obj_set_size(cover, LV_PCT(100), LV_PCT(100));
+  lv_obj_set_style_bg_opa(cover, LV_OPA_COVER, 0);
+  lv_obj_set_style_bg_color(cover, lv_color_black(), 0);
+  lv_refr_now(NULL);
+  lv_obj_set_style_bg_color(cover, lv_color_white(), 0);
+  lv_refr_now(NULL);
+  lv_obj_del(cover);
+  lv_refr_now(NULL);
+  wipes++;
+}
+
+static void clean(CleanReason reason, uint16_t worst) {
+  Decision *d = &decisions[num_decisions++ % LOG_SIZE];
+
+  d->uptime_ms = k_uptime_get();
+  d->app = current;
+  d->reason = reason;
+  d->worst = worst;
+  cleans[reason]++;
+
+  // The whole screen is written again and goes out as one full refresh
+  cleaning = true;
+  if (display && display_blanking_on(display) == 0) {
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    display_blanking_off(display);
+  } else {
+    wipe();
+  }
+  cleaning = false;
+
+  changed = false;
+  switched = false;
+  memset(damage, 0, sizeof(damage));
+}
+
+void refresh_init(void) {
+  lv_display_t *disp = lv_display_get_default();
+
+  if (!disp) {
+    LOG_ERR("No display, refresh manager disabled");
+    return;
+  }
+  region_w = DIV_ROUND_UP(lv_display_get_horizontal_resolution(disp),
+                          REGION_COLS);
+  region_h =
+      DIV_ROUND_UP(lv_display_get_vertical_resolution(disp), REGION_ROWS);
+  lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_INVALIDATE_AREA,
+                          NULL);
+  lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_FINISH, NULL);
+
+  // Whatever the panel showed before power-up is unknown ghost
+  atomic_set(&clean_pending, CLEAN_BOOT + 1);
+}
+
+void refresh_set_app(const App *app) {
+  current = app;
+  switched = true;
+  add_damage(0, 0, REGION_COLS - 1, REGION_ROWS - 1, SWITCH_DAMAGE);
+}
+
+void refresh_poll(void) {
+  const PolicyDef *policy = &policies[current_policy()];
+  uint16_t worst = worst_damage();
+  atomic_val_t requested = atomic_set(&clean_pending, 0);
+
+  if (atomic_cas(&reset_pending, 1, 0)) {
+    partials = wipes = num_decisions = 0;
+    memset(cleans, 0, sizeof(cleans));
+  }
+
+  if (requested) {
+    clean(requested - 1, worst);
+    return;
+  }
+
+  // The frame about to render: partial while the budget lasts
+  if (changed) {
+    if (policy->budget == 0)
+      clean(CLEAN_POLICY, worst);
+    else if (worst >= policy->budget)
+      clean(switched ? CLEAN_SWITCH : CLEAN_BUDGET, worst);
+    return;
+  }
+
+  // Still screen: clean up what is left once it has been still long enough
+  if (worst < policy->idle_min)
+    return;
+  int64_t idle_at = last_change + policy->idle_ms;
+  int64_t now = k_uptime_get();
+  if (now >= idle_at)
+    clean(CLEAN_IDLE, worst);
+  else
+    request_update_in(idle_at - now);
+}
+
+/* Shell: badge refresh [clean|reset|auto|fast|balanced|quality] */
+static int cmd_refresh(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "clean") == 0) {
+      atomic_set(&clean_pending, CLEAN_SHELL + 1);
+      wake_launcher();
+      return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0) {
+      atomic_set(&reset_pending, 1);
+      return 0;
+    }
+    if (strcmp(argv[1], "auto") == 0) {
+      atomic_set(&policy_override, 0);
+      return 0;
+    }
+    for (int i = 0; i < ARRAY_SIZE(policies); i++) {
+      if (strcmp(argv[1], policies[i].name) == 0) {
+        atomic_set(&policy_override, i + 1);
+        wake_launcher();
+        return 0;
+      }
+    }
+    shell_error(sh, "Usage: badge refresh "
+                    "[clean|reset|auto|fast|balanced|quality]");
+    return -EINVAL;
+  }
+
+  const PolicyDef *policy = &policies[current_policy()];
+  shell_print(sh, "Policy: %s%s for %s, budget %u, idle clean after %u ms",
+              policy->name, atomic_get(&policy_override) ? " (forced)" : "",
+              current ? current->name : "-", policy->budget, policy->idle_ms);
+  shell_print(sh, "Damage per region (partial refreshes since the last full):");
+  for (int y = 0; y < REGION_ROWS; y++)
+    shell_print(sh, "  %5u %5u %5u %5u", damage[y][0], damage[y][1],
+                damage[y][2], damage[y][3]);
+  shell_print(sh, "Partial: %u, full: %u by blanking, %u by wipe", partials,
+              num_decisions - wipes, wipes);
+  shell_print(sh, "  boot %u, policy %u, budget %u, switch %u, idle %u, "
+                  "shell %u",
+              cleans[CLEAN_BOOT], cleans[CLEAN_POLICY], cleans[CLEAN_BUDGET],
+              cleans[CLEAN_SWITCH], cleans[CLEAN_IDLE], cleans[CLEAN_SHELL]);
+
+  uint32_t shown = MIN(num_decisions, LOG_SIZE);
+  for (uint32_t i = num_decisions - shown; i < num_decisions; i++) {
+    const Decision *d = &decisions[i % LOG_SIZE];
+    shell_print(sh, "  %lld ms: %s, %s, worst region %u",
+                (long long)d->uptime_ms, d->app ? d->app->name : "-",
+                reason_names[d->reason], d->worst);
+  }
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), refresh, NULL,
+                 "E-ink partial/full refresh decisions\n"
+                 "Usage: badge refresh [clean|reset|auto|fast|balanced|"
+                 "quality]",
+                 cmd_refresh, 1, 1);
@@ -0,0 +1,28 @@
+#ifndef REFRESH_H
+#define REFRESH_H
+
+#include "app_shared.h"
+
+/*
+ * E-ink refresh manager. Every flush is a partial refresh; the manager
+ * counts them per region of the panel (its ghosting damage) and turns a
+ * frame into a full refresh once the foreground app's RefreshPolicy budget
+ * is spent, or cleans up leftover damage once the screen has been still for
+ * a while. Full refreshes go through display blanking (the EPD drivers hold
+ * the writes and show them with a full waveform); panels without blanking
+ * get a black/white wipe instead. Decisions are on "badge refresh".
+ */
+
+/* Hooks the default display's invalidate/flush events. Call once LVGL is up. */
+void refresh_init(void);
+
+/* The app whose screen is about to be loaded: its policy, plus switch damage */
+void refresh_set_app(const App *app);
+
+/*
+ * Call before rendering: may render the pending changes right away as a full
+ * refresh. Requests a wakeup for the next idle clean when one is due.
+ */
+void refresh_poll(void);
+
+#endif
@@ -0,0 +1,184 @@
+#include "screen_cache.h"
+
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+typedef struct {
+  const App *app;
+  lv_obj_t *scr;
+  size_t cost;       // LVGL heap bytes taken when the screen was built
+  uint32_t last_use; // Close order, lowest is evicted first
+} CachedScreen;
+
+static CachedScreen cache[CONFIG_BADGE_SCREEN_CACHE_SLOTS];
+static uint32_t use_counter;
+static size_t open_cost; // Cost of the screen currently on display
+
+static uint32_t hits;
+static uint32_t misses;
+static uint32_t evictions;
+
+/* Flush is requested from the shell thread, applied on the next switch */
+static atomic_t flush_pending;
+
+static size_t lvgl_heap_used(void) {
+  lv_mem_monitor_t mon;
+
+  lv_mem_monitor(&mon);
+  return mon.total_size - mon.free_size;
+}
+
+static size_t cached_bytes(void) {
+  size_t total = 0;
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].app)
+      total += cache[i].cost;
+  }
+  return total;
+}
+
+static void evict(CachedScreen *entry) {
+  LOG_DBG("Evicting %s (%u bytes)", entry->app->name, (unsigned)entry->cost);
+
+  if (entry->app->exit)
+    entry->app->exit();
+  lv_obj_del(entry->scr);
+  memset(entry, 0, sizeof(*entry));
+  evictions++;
+}
+
+static CachedScreen *least_recently_used(void) {
+  CachedScreen *lru = NULL;
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].app && (!lru || cache[i].last_use < lru->last_use))
+      lru = &cache[i];
+  }
+  return lru;
+}
+
+static void apply_pending_flush(void) {
+  if (!atomic_cas(&flush_pending, 1, 0))
+    return;
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].app)
+      evict(&cache[i]);
+  }
+}
+
+lv_obj_t *screen_cache_open(const App *app) {
+  apply_pending_flush();
+
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].app != app)
+      continue;
+
+    // Warm: hand the retained tree back as-is
+    lv_obj_t *scr = cache[i].scr;
+    open_cost = cache[i].cost;
+    memset(&cache[i], 0, sizeof(cache[i]));
+    hits++;
+
+    app->resume();
+    return scr;
+  }
+
+  // Cold: build a fresh screen
+  size_t used_before = lvgl_heap_used();
+  lv_obj_t *scr = lv_obj_create(NULL);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+
+  app->enter(scr);
+
+  size_t used_after = lvgl_heap_used();
+  open_cost = used_after > used_before ? used_after - used_before : 0;
+  misses++;
+
+  return scr;
+}
+
+void screen_cache_close(const App *app, lv_obj_t *scr) {
+  apply_pending_flush();
+
+  if (!app->resume || open_cost > CONFIG_BADGE_SCREEN_CACHE_BUDGET) {
+    if (app->exit)
+      app->exit();
+    lv_obj_del(scr);
+    return;
+  }
+
+  if (app->suspend)
+    app->suspend();
+
+  // Make room: a free slot and enough budget for this screen
+  CachedScreen *slot = NULL;
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (!cache[i].app) {
+      slot = &cache[i];
+      break;
+    }
+  }
+  if (!slot) {
+    slot = least_recently_used();
+    evict(slot);
+  }
+  while (cached_bytes() + open_cost > CONFIG_BADGE_SCREEN_CACHE_BUDGET)
+    evict(least_recently_used());
+
+  slot->app = app;
+  slot->scr = scr;
+  slot->cost = open_cost;
+  slot->last_use = ++use_counter;
+}
+
+void screen_cache_discard(const App *app) {
+  for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+    if (cache[i].app == app)
+      evict(&cache[i]);
+  }
+}
+
+/* Shell: badge cache [flush] */
+static int cmd_cache(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "flush") != 0) {
+      shell_error(sh, "Usage: badge cache [flush]");
+      return -EINVAL;
+    }
+    atomic_set(&flush_pending, 1);
+    shell_print(sh, "Retained screens dropped on the next app switch");
+    return 0;
+  }
+
+  shell_print(sh, "Retained: %u / %u bytes (LVGL heap in use: %u)",
+              (unsigned)cached_bytes(), CONFIG_BADGE_SCREEN_CACHE_BUDGET,
+              (unsigned)lvgl_heap_used());
+  shell_print(sh, "Hits: %u, misses: %u, evictions: %u", hits, misses,
+              evictions);
+
+  // Most recently used first
+  uint32_t below = UINT32_MAX;
+  for (int n = 0; n < ARRAY_SIZE(cache); n++) {
+    const CachedScreen *next = NULL;
+    for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+      if (cache[i].app && cache[i].last_use < below &&
+          (!next || cache[i].last_use > next->last_use))
+        next = &cache[i];
+    }
+    if (!next)
+      break;
+    shell_print(sh, "  %-16s %6u bytes", next->app->name,
+                (unsigned)next->cost);
+    below = next->last_use;
+  }
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), cache, NULL,
+                 "Retained app screens (LRU)\nUsage: badge cache [flush]",
+                 cmd_cache, 1, 1);
@@ -0,0 +1,23 @@
+#ifndef SCREEN_CACHE_H
+#define SCREEN_CACHE_H
+
+#include "app_shared.h"
+
+/*
+ * Retained app screens. Apps with a resume() hook keep their screen tree
+ * when the user leaves them; the next visit reloads it instead of calling
+ * enter(). Inactive screens are evicted least-recently-used first once their
+ * LVGL heap cost exceeds CONFIG_BADGE_SCREEN_CACHE_BUDGET, and exit() runs
+ * on eviction. Apps without resume() are built and torn down every visit.
+ */
+
+/* Returns app's screen (not loaded): a retained one resumed, or a new one */
+lv_obj_t *screen_cache_open(const App *app);
+
+/* app is leaving scr (no longer the active screen): retain or destroy it */
+void screen_cache_close(const App *app, lv_obj_t *scr);
+
+/* Destroys app's retained screen, if any, so the next open starts cold */
+void screen_cache_discard(const App *app);
+
+#endif
@@ -27,12 +27,13 @@ static void serial_cb(const struct device *dev, void *user_data) {
     while (uart_fifo_read(dev, &c, 1) == 1) {
       ring_buf_put(&ringbuf, &c, 1);
     }
+    wake_launcher();
   }
 }
 
-static void serial_monitor_enter(void) {
+static void serial_monitor_enter(lv_obj_t *scr) {
   // UI Setup
-  main_cont = lv_obj_create(lv_scr_act());
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_flex_flow(main_cont, LV_FLEX_FLOW_COLUMN);
   lv_obj_set_flex_align(main_cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER,
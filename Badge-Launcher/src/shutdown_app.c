@@ -6,13 +6,12 @@ LOG_MODULE_DECLARE(badge_launcher);
 // Declare the QR Code image asset
 LV_IMG_DECLARE(qr_code);
 
-static void shutdown_enter(void) {
-  lv_obj_clean(lv_scr_act());
-  lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+static void shutdown_enter(lv_obj_t *scr) {
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
 
   // Main Container - Full Screen, Centered Column
-  lv_obj_t *cont = lv_obj_create(lv_scr_act());
+  lv_obj_t *cont = lv_obj_create(scr);
   lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_opa(cont, LV_OPA_TRANSP, 0);
   lv_obj_set_style_border_width(cont, 0, 0);
@@ -45,7 +44,7 @@ static void shutdown_enter(void) {
   // Image is 128x128, will be centered by flex align
 
   // Explicitly invalidate to ensure full draw
-  lv_obj_invalidate(lv_scr_act());
+  lv_obj_invalidate(scr);
 }
 
 static void shutdown_update(void) {
@@ -59,4 +58,5 @@ static void shutdown_exit(void) {
 App shutdown_app = {.name = "Shutdown",
                     .enter = shutdown_enter,
                     .update = shutdown_update,
-                    .exit = shutdown_exit};
+                    .exit = shutdown_exit,
+                    .refresh = REFRESH_QUALITY}; // Stays up while off
@@ -1,5 +1,5 @@
 #include "snake_game.h"
-#include <zephyr/random/random.h>
+#include "tile_map.h"
 
 LOG_MODULE_DECLARE(badge_launcher);
 
@@ -28,7 +28,6 @@ static Point food;
 static bool game_over;
 static bool paused;
 static int score;
-static int64_t last_tick;
 
 /* UI Elements */
 static lv_obj_t *score_label;
@@ -36,21 +35,18 @@ static lv_obj_t *game_over_label;
 static lv_obj_t *paused_label;
 static lv_obj_t *snake_body_container;
 
-/* Static Grid of Objects */
-static lv_obj_t *grid_objs[GRID_COLS][GRID_ROWS];
+/* Board: snake and food are plain black blocks */
+#define TILE_BLOCK 1
 
-static void set_block_color(int x, int y, lv_color_t color) {
-  if (x >= 0 && x < GRID_COLS && y >= 0 && y < GRID_ROWS && grid_objs[x][y]) {
-    lv_obj_set_style_bg_color(grid_objs[x][y], color, 0);
-  }
-}
+static const TileDef tiles[] = {[TILE_BLOCK] = {.shape = TILE_FILL}};
+static TileMap board;
 
 static void spawn_food() {
   bool on_snake;
   do {
     on_snake = false;
-    food.x = sys_rand32_get() % GRID_COLS;
-    food.y = sys_rand32_get() % GRID_ROWS;
+    food.x = app_rand32() % GRID_COLS;
+    food.y = app_rand32() % GRID_ROWS;
 
     for (int i = 0; i < snake_len; i++) {
       if (snake[i].x == food.x && snake[i].y == food.y) {
@@ -60,16 +56,12 @@ static void spawn_food() {
     }
   } while (on_snake);
 
-  set_block_color(food.x, food.y, lv_color_black());
+  tile_map_set(&board, food.x, food.y, TILE_BLOCK);
 }
 
 static void init_game_logic() {
   // Clear Grid visually
-  for (int x = 0; x < GRID_COLS; x++) {
-    for (int y = 0; y < GRID_ROWS; y++) {
-      set_block_color(x, y, lv_color_white());
-    }
-  }
+  tile_map_fill(&board, TILE_EMPTY);
 
   snake_len = 3;
   snake[0].x = GRID_COLS / 2;
@@ -81,7 +73,7 @@ static void init_game_logic() {
 
   // Draw initial snake
   for (int i = 0; i < snake_len; i++) {
-    set_block_color(snake[i].x, snake[i].y, lv_color_black());
+    tile_map_set(&board, snake[i].x, snake[i].y, TILE_BLOCK);
   }
 
   current_dir = DIR_UP;
@@ -98,6 +90,7 @@ static void init_game_logic() {
     lv_label_set_text(score_label, "Score: 0");
 
   spawn_food();
+  tile_map_commit(&board);
 }
 
 /* Input Queue */
@@ -107,12 +100,6 @@ static int queue_count = 0;
 static int queue_head = 0;
 static int queue_tail = 0;
 
-static int prev_btn_up = 0;
-static int prev_btn_down = 0;
-static int prev_btn_left = 0;
-static int prev_btn_right = 0;
-static int prev_btn_select = 0;
-
 static void queue_reset() {
   queue_count = 0;
   queue_head = 0;
@@ -162,7 +149,7 @@ static void try_enqueue_move(Direction dir) {
   queue_count++;
 }
 
-static void update_logic() {
+static void update_logic(void) {
   if (game_over || paused)
     return;
 
@@ -236,25 +223,22 @@ static void update_logic() {
 
   // Redraw Board
   // 1. Clear All
-  for (int x = 0; x < GRID_COLS; x++) {
-    for (int y = 0; y < GRID_ROWS; y++) {
-      set_block_color(x, y, lv_color_white());
-    }
-  }
+  tile_map_fill(&board, TILE_EMPTY);
   // 2. Draw Snake
   for (int i = 0; i < snake_len; i++) {
-    set_block_color(snake[i].x, snake[i].y, lv_color_black());
+    tile_map_set(&board, snake[i].x, snake[i].y, TILE_BLOCK);
   }
   // 3. Draw Food
-  set_block_color(food.x, food.y, lv_color_black());
+  tile_map_set(&board, food.x, food.y, TILE_BLOCK);
+  // 4. Only the cells that changed reach the display
+  tile_map_commit(&board);
 }
 
-static void snake_enter(void) {
-  lv_obj_clean(lv_scr_act());
-  lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
-  lv_obj_clear_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
+static void snake_enter(lv_obj_t *scr) {
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+  lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
 
-  snake_body_container = lv_obj_create(lv_scr_act());
+  snake_body_container = lv_obj_create(scr);
   lv_obj_set_size(snake_body_container, SCREEN_WIDTH, SCREEN_HEIGHT);
   lv_obj_set_style_bg_opa(snake_body_container, 0, 0);
   lv_obj_set_style_border_width(snake_body_container, 0, 0);
@@ -262,38 +246,25 @@ static void snake_enter(void) {
   lv_obj_set_style_pad_all(snake_body_container, 0, 0);
   lv_obj_clear_flag(snake_body_container, LV_OBJ_FLAG_SCROLLABLE);
 
-  // Initialize Static Grid
-  for (int x = 0; x < GRID_COLS; x++) {
-    for (int y = 0; y < GRID_ROWS; y++) {
-      lv_obj_t *obj = lv_obj_create(snake_body_container);
-      if (!obj) {
-        LOG_ERR("Failed to create grid object at %d,%d", x, y);
-        continue;
-      }
-      lv_obj_set_size(obj, BLOCK_SIZE, BLOCK_SIZE);
-      lv_obj_set_pos(obj, x * BLOCK_SIZE, y * BLOCK_SIZE);
-      lv_obj_set_style_radius(obj, 0, 0);
-      lv_obj_set_style_border_width(obj, 0, 0);
-      lv_obj_set_style_bg_color(obj, lv_color_white(), 0); // Start White
-      grid_objs[x][y] = obj;
-    }
-  }
+  // Board, one object for the whole grid
+  tile_map_create(&board, snake_body_container, GRID_COLS, GRID_ROWS,
+                  BLOCK_SIZE, tiles, ARRAY_SIZE(tiles));
 
-  score_label = lv_label_create(lv_scr_act());
+  score_label = lv_label_create(scr);
   lv_label_set_text(score_label, "Score: 0");
   lv_obj_set_style_text_color(score_label, lv_color_black(), 0);
   lv_obj_align(score_label, LV_ALIGN_TOP_LEFT, 5, 5);
   // Ensure label is above grid
   lv_obj_move_foreground(score_label);
 
-  game_over_label = lv_label_create(lv_scr_act());
+  game_over_label = lv_label_create(scr);
   lv_label_set_text(game_over_label, "GAME OVER");
   lv_obj_set_style_text_color(game_over_label, lv_color_make(0, 0, 0), 0);
   lv_obj_align(game_over_label, LV_ALIGN_CENTER, 0, 0);
   lv_obj_add_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
   lv_obj_move_foreground(game_over_label);
 
-  paused_label = lv_label_create(lv_scr_act());
+  paused_label = lv_label_create(scr);
   lv_label_set_text(paused_label, "PAUSED");
   lv_obj_set_style_text_color(paused_label, lv_color_black(), 0);
   lv_obj_align(paused_label, LV_ALIGN_CENTER, 0, 0);
@@ -302,29 +273,24 @@ static void snake_enter(void) {
 
   init_game_logic();
   queue_reset();
-  last_tick = k_uptime_get();
 }
 
-static void snake_update(void) {
-  // Input Polling (Edge Detection)
-  int curr_up = gpio_pin_get_dt(&btn_up);
-  int curr_down = gpio_pin_get_dt(&btn_down);
-  int curr_left = gpio_pin_get_dt(&btn_left);
-  int curr_right = gpio_pin_get_dt(&btn_right);
-  int curr_select = gpio_pin_get_dt(&btn_select);
+static void snake_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
   if (!paused) {
-    if (curr_up && !prev_btn_up)
+    if (evt->button == BTN_UP)
       try_enqueue_move(DIR_UP);
-    if (curr_down && !prev_btn_down)
+    if (evt->button == BTN_DOWN)
       try_enqueue_move(DIR_DOWN);
-    if (curr_left && !prev_btn_left)
+    if (evt->button == BTN_LEFT)
       try_enqueue_move(DIR_LEFT);
-    if (curr_right && !prev_btn_right)
+    if (evt->button == BTN_RIGHT)
       try_enqueue_move(DIR_RIGHT);
   }
 
-  if (curr_select && !prev_btn_select) {
+  if (evt->button == BTN_SELECT) {
     if (game_over) {
       init_game_logic();
       queue_reset();
@@ -337,25 +303,30 @@ static void snake_update(void) {
       }
     }
   }
+}
 
-  prev_btn_up = curr_up;
-  prev_btn_down = curr_down;
-  prev_btn_left = curr_left;
-  prev_btn_right = curr_right;
-  prev_btn_select = curr_select;
-
-  int64_t now = k_uptime_get();
-  if (now - last_tick > 100) {
-    update_logic();
-    last_tick = now;
+// Screen is retained while away: come back paused rather than mid-crash
+static void snake_suspend(void) {
+  if (!game_over) {
+    paused = true;
+    lv_obj_clear_flag(paused_label, LV_OBJ_FLAG_HIDDEN);
   }
 }
 
+static void snake_resume(void) {
+  // Still paused from suspend, SELECT continues
+}
+
 static void snake_exit(void) {
-  // Cleanup happens via screen clean in main
+  // Cleanup happens when the launcher deletes the screen
 }
 
 App snake_game_app = {.name = "Snake",
                       .enter = snake_enter,
-                      .update = snake_update,
-                      .exit = snake_exit};
+                      .input = snake_input,
+                      .exit = snake_exit,
+                      .suspend = snake_suspend,
+                      .resume = snake_resume,
+                      .tick_ms = 100,
+                      .tick = update_logic,
+                      .refresh = REFRESH_FAST};
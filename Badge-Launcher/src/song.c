@@ -0,0 +1,62 @@
+#include "song.h"
+
+// Where a cursor starts and finishes: reading it moves to the next pattern
+static const uint8_t pattern_end[] = {SONG_END};
+
+void song_begin(SongCursor *c, const Song *song, int track) {
+  *c = (SongCursor){
+      .song = song,
+      .order = song->orders[track],
+      .pos = pattern_end,
+  };
+}
+
+static bool next_pattern(SongCursor *c) {
+  if (c->passes_left) {
+    c->passes_left--;
+    c->pos = c->pattern;
+    return true;
+  }
+
+  uint8_t entry = *c->order;
+  if (entry == SONG_END) {
+    c->pos = pattern_end;
+    return false;
+  }
+  c->order++;
+  if (entry & 0x80) {
+    c->passes_left = (entry & 0x7f) - 1;
+    entry = *c->order++;
+  }
+  c->pattern = c->pos = c->song->patterns[entry];
+  c->loop_left = 0;
+  return true;
+}
+
+bool song_next(SongCursor *c, SongNote *note) {
+  for (;;) {
+    uint8_t op = *c->pos++;
+
+    if (op < 0x80) {
+      bool pitched = op >= song_note_lo && op <= song_note_hi;
+      note->period_ns = pitched ? song_period_ns[op - song_note_lo] : 0;
+      note->ms = c->ms;
+      return true;
+    }
+
+    if (op < 0xc0) {
+      c->ms = c->song->durations[op & 0x3f];
+    } else if (op == SONG_LOOP_END) {
+      if (c->loop_left) {
+        c->loop_left--;
+        c->pos = c->loop;
+      }
+    } else if (op == SONG_END) {
+      if (!next_pattern(c))
+        return false;
+    } else if ((op & 0xf0) == 0xe0) {
+      c->loop = c->pos;
+      c->loop_left = (op & 0x0f) - 1;
+    }
+  }
+}
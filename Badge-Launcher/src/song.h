@@ -0,0 +1,67 @@
+#ifndef SONG_H
+#define SONG_H
+
+#include "app_shared.h"
+
+/*
+ * Tracker-style song format, generated from the RTTTL and MIDI files in
+ * songs/ by convert_songs.py. A song has one to SONG_MAX_TRACKS tracks
+ * played together, each an order list naming patterns from the song's
+ * shared pool; a pattern is a byte string:
+ *   0x00-0x7f  MIDI note number (0 is a rest), held for the current duration
+ *   SONG_DUR   picks the current duration from the song's duration table
+ *   SONG_LOOP  plays everything up to SONG_LOOP_END n times (no nesting)
+ *   SONG_END   ends the pattern
+ * Every pattern sets its duration before its first note. In the order list
+ * SONG_REPEAT(n) plays the next pattern n times, SONG_END ends the song.
+ * The decoder walks this in place, a SongCursor per track is all the state
+ * it needs. The noise track, if any, holds drum hits: its notes set the
+ * noise pitch.
+ */
+#define SONG_MAX_TRACKS 4 // Three square voices and noise (see mixer.h)
+#define SONG_NO_NOISE -1
+
+#define SONG_DUR(code) (0x80 | (code)) // code = 0..63
+#define SONG_LOOP(n) (0xe0 | (n))      // n = 2..15
+#define SONG_LOOP_END 0xf0
+#define SONG_END 0xff
+#define SONG_REPEAT(n) (0x80 | (n)) // Order list only, n = 2..127
+
+typedef struct {
+  const char *title;
+  const uint8_t *const *orders; // One per track
+  const uint8_t *const *patterns;
+  const uint16_t *durations; // ms, indexed by SONG_DUR code
+  uint8_t tracks;
+  int8_t noise_track; // Or SONG_NO_NOISE
+} Song;
+
+typedef struct {
+  uint32_t period_ns; // 0 for a rest
+  uint16_t ms;
+} SongNote;
+
+typedef struct {
+  const Song *song;
+  const uint8_t *order;   // Next order list entry
+  const uint8_t *pattern; // Start of the current pattern
+  const uint8_t *pos;     // Next pattern byte
+  const uint8_t *loop;    // First byte of the open loop
+  uint8_t loop_left;      // Loop passes still to go
+  uint8_t passes_left;    // Passes of the current pattern still to go
+  uint16_t ms;            // Current duration
+} SongCursor;
+
+/* Generated tables (songs.c in the build directory) */
+extern const Song songs[];
+extern const int song_count;
+extern const uint8_t song_note_lo; // Lowest and highest note of any song
+extern const uint8_t song_note_hi;
+extern const uint32_t song_period_ns[]; // From song_note_lo up
+
+void song_begin(SongCursor *c, const Song *song, int track);
+
+/* Next note of the song, false once it has ended */
+bool song_next(SongCursor *c, SongNote *note);
+
+#endif
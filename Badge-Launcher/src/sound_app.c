@@ -0,0 +1,188 @@
+#include "sound_app.h"
+#include "audio.h"
+
+/*
+ * Settings > Sound: mute plus a volume level per audio category. Changes
+ * apply at once (music follows while it plays) and are saved on the way
+ * out.
+ */
+typedef struct {
+  const char *name;
+  int category; // AudioCategory, -1 for the mute row
+} SoundRow;
+
+static const SoundRow rows[] = {
+    {"Sound", -1},
+    {"Menu clicks", AUDIO_UI},
+    {"Game effects", AUDIO_SFX},
+    {"Music", AUDIO_MUSIC},
+};
+#define NUM_ROWS ARRAY_SIZE(rows)
+
+static lv_obj_t *row_conts[NUM_ROWS];
+static lv_obj_t *row_labels[NUM_ROWS];
+static lv_obj_t *row_values[NUM_ROWS]; // Label for mute, bar for levels
+static int selected;
+static bool changed; // Since entering, save on exit
+
+static void refresh(void) {
+  for (int i = 0; i < NUM_ROWS; i++) {
+    bool sel = i == selected;
+    lv_color_t fg = sel ? lv_color_white() : lv_color_black();
+
+    lv_obj_set_style_bg_color(row_conts[i],
+                              sel ? lv_color_black() : lv_color_white(), 0);
+    lv_obj_set_style_text_color(row_labels[i], fg, 0);
+
+    if (rows[i].category < 0) {
+      lv_label_set_text(row_values[i], audio_muted() ? "OFF" : "ON");
+      lv_obj_set_style_text_color(row_values[i], fg, 0);
+    } else {
+      lv_bar_set_value(row_values[i], audio_level(rows[i].category),
+                       LV_ANIM_OFF);
+    }
+  }
+}
+
+// A sample of the category at its new level
+static void preview(int category) {
+  if (category == AUDIO_UI)
+    play_beep_move();
+  else if (category == AUDIO_SFX)
+    play_beep_eat();
+}
+
+static void adjust(int delta, bool wrap) {
+  const SoundRow *row = &rows[selected];
+
+  if (row->category < 0) {
+    // LEFT turns sound off, RIGHT on, SELECT toggles
+    audio_set_muted(wrap ? !audio_muted() : delta < 0);
+    if (!audio_muted())
+      play_beep_move();
+  } else {
+    int level = audio_level(row->category) + delta;
+
+    if (wrap && level > AUDIO_LEVEL_MAX)
+      level = 0;
+    level = CLAMP(level, 0, AUDIO_LEVEL_MAX);
+    audio_set_level(row->category, level);
+    preview(row->category);
+  }
+  changed = true;
+  refresh();
+}
+
+static lv_obj_t *create_row(lv_obj_t *parent, int i) {
+  lv_obj_t *cont = lv_obj_create(parent);
+  lv_obj_set_size(cont, LV_PCT(100), 40);
+  lv_obj_set_style_pad_hor(cont, 10, 0);
+  lv_obj_set_style_border_width(cont, 1, 0);
+  lv_obj_set_style_border_color(cont, lv_color_black(), 0);
+  lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, 0);
+  lv_obj_set_style_radius(cont, 0, 0); // Sharp E-Ink look
+  lv_obj_clear_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+
+  row_labels[i] = lv_label_create(cont);
+  lv_label_set_text(row_labels[i], rows[i].name);
+  lv_obj_set_style_text_font(row_labels[i], &lv_font_montserrat_18, 0);
+  lv_obj_align(row_labels[i], LV_ALIGN_LEFT_MID, 0, 0);
+
+  if (rows[i].category < 0) {
+    row_values[i] = lv_label_create(cont);
+    lv_obj_set_style_text_font(row_values[i], &lv_font_montserrat_18, 0);
+  } else {
+    // Level as a bar, white inside a border so it reads on either row color
+    lv_obj_t *bar = lv_bar_create(cont);
+    lv_obj_set_size(bar, 100, 14);
+    lv_bar_set_range(bar, 0, AUDIO_LEVEL_MAX);
+    lv_obj_set_style_bg_color(bar, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(bar, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_border_width(bar, 2, LV_PART_MAIN);
+    lv_obj_set_style_outline_color(bar, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_outline_width(bar, 1, LV_PART_MAIN);
+    lv_obj_set_style_radius(bar, 0, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(bar, lv_color_black(), LV_PART_INDICATOR);
+    lv_obj_set_style_radius(bar, 0, LV_PART_INDICATOR);
+    row_values[i] = bar;
+  }
+  lv_obj_align(row_values[i], LV_ALIGN_RIGHT_MID, 0, 0);
+  return cont;
+}
+
+static void sound_enter(lv_obj_t *scr) {
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+
+  // Header (Title)
+  lv_obj_t *header = lv_label_create(scr);
+  lv_label_set_text(header, "SOUND");
+  lv_obj_set_style_text_font(header, &lv_font_montserrat_24, 0);
+  lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 10);
+
+  lv_obj_t *list = lv_obj_create(scr);
+  lv_obj_set_size(list, 300, NUM_ROWS * 40);
+  lv_obj_align_to(list, header, LV_ALIGN_OUT_BOTTOM_MID, 0, 15);
+  lv_obj_set_style_pad_all(list, 0, 0);
+  lv_obj_set_style_pad_gap(list, 0, 0);
+  lv_obj_set_style_border_width(list, 0, 0);
+  lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+  lv_obj_clear_flag(list, LV_OBJ_FLAG_SCROLLABLE);
+
+  for (int i = 0; i < NUM_ROWS; i++)
+    row_conts[i] = create_row(list, i);
+
+  lv_obj_t *hint = lv_label_create(scr);
+  lv_label_set_text(hint, "UP/DOWN: Choose  LEFT/RIGHT: Level\n"
+                          "SELECT: Toggle/Cycle  BACK: Save & Exit");
+  lv_obj_set_style_text_align(hint, LV_TEXT_ALIGN_CENTER, 0);
+  lv_obj_set_style_text_font(hint, &lv_font_montserrat_14, 0);
+  lv_obj_align(hint, LV_ALIGN_BOTTOM_MID, 0, -10);
+
+  selected = 0;
+  changed = false;
+  refresh();
+}
+
+static void sound_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
+
+  switch (evt->button) {
+  case BTN_UP:
+    if (selected > 0)
+      selected--;
+    refresh();
+    break;
+  case BTN_DOWN:
+    if (selected < NUM_ROWS - 1)
+      selected++;
+    refresh();
+    break;
+  case BTN_LEFT:
+    adjust(-1, false);
+    break;
+  case BTN_RIGHT:
+    adjust(1, false);
+    break;
+  case BTN_SELECT:
+    adjust(1, true);
+    break;
+  default:
+    break;
+  }
+}
+
+static void sound_update(void) {}
+
+// Once per visit: flash writes are not free
+static void sound_exit(void) {
+  if (changed)
+    audio_save_settings();
+}
+
+App sound_app = {.name = "Sound",
+                 .enter = sound_enter,
+                 .update = sound_update,
+                 .input = sound_input,
+                 .exit = sound_exit};
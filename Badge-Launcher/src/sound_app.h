@@ -0,0 +1,8 @@
+#ifndef SOUND_APP_H
+#define SOUND_APP_H
+
+#include "app_shared.h"
+
+extern App sound_app;
+
+#endif
@@ -1,5 +1,6 @@
 #include "space_invaders.h"
-#include <zephyr/random/random.h>
+#include "audio.h"
+#include "tile_map.h"
 
 LOG_MODULE_REGISTER(space_invaders, LOG_LEVEL_INF);
 
@@ -10,16 +11,36 @@ LOG_MODULE_REGISTER(space_invaders, LOG_LEVEL_INF);
 #define COLS (SCREEN_WIDTH / CELL_SIZE)
 #define ROWS (SCREEN_HEIGHT / CELL_SIZE)
 
+#define TICK_MS 100
+
 #define PLAYER_Y (ROWS - 1)
 #define MAX_PROJECTILES 5
 #define MAX_INVADERS (COLS * (ROWS / 2))
 
+// --- Sounds ---
+static const SfxDef sfx_shot = {.name = "shot",
+                                .start_hz = 1800,
+                                .end_hz = 400,
+                                .duration_ms = 60,
+                                .curve = SFX_LINEAR_PERIOD,
+                                .duty = 25,
+                                .decay_ms = 30};
+
+static const SfxDef sfx_invader_hit = {.name = "invader hit",
+                                       .start_hz = 700,
+                                       .end_hz = 90,
+                                       .duration_ms = 150,
+                                       .duty = 12,
+                                       .decay_ms = 120,
+                                       .priority = 1,
+                                       .arp_ms = 8,
+                                       .arp_steps = 2,
+                                       .arp = {0, -5}};
+
 // --- Game State ---
 static int player_x; // Column Index
 static int score;
 static bool game_over;
-static int64_t last_tick;
-static int64_t last_move_tick;
 
 typedef struct {
   int x; // Col
@@ -39,50 +60,120 @@ static int invader_count;
 
 // Invader Movement State
 static int invader_move_dir; // 1 (Right) or -1 (Left)
-static int invader_move_timer;
+static int invader_move_timer; // ms accumulated since the last move
 static int invader_move_speed; // ms delay
 
 // --- UI Objects ---
 static lv_obj_t *main_cont;
 static lv_obj_t *score_label;
 static lv_obj_t *game_over_label;
-static lv_obj_t *grid_cells[COLS][ROWS]; // Static Grid
 
-// --- Input ---
-static int btn_up_prev = 0;
-static int btn_select_prev = 0;
-// Note: Left/Right are polled directly
+// Board: 10x10 pixel art at double size
+#define TILE_INVADER 1
+#define TILE_SHIP 2
+#define TILE_SHOT 3
+
+static const uint8_t invader_bits[] = {
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+    0x0c, 0x03, 0x00, // ..#....#..
+    0x0c, 0x03, 0x00,
+    0x03, 0x0c, 0x00, // ...#..#...
+    0x03, 0x0c, 0x00,
+    0x0f, 0xff, 0x00, // ..######..
+    0x0f, 0xff, 0x00,
+    0x3c, 0xf3, 0xc0, // .##.##.##.
+    0x3c, 0xf3, 0xc0,
+    0xff, 0xff, 0xf0, // ##########
+    0xff, 0xff, 0xf0,
+    0xcf, 0xff, 0x30, // #.######.#
+    0xcf, 0xff, 0x30,
+    0xcc, 0x03, 0x30, // #.#....#.#
+    0xcc, 0x03, 0x30,
+    0x0f, 0x0f, 0x00, // ..##..##..
+    0x0f, 0x0f, 0x00,
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+};
+static const uint8_t ship_bits[] = {
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x03, 0xfc, 0x00, // ...####...
+    0x03, 0xfc, 0x00,
+    0x3f, 0xff, 0xc0, // .########.
+    0x3f, 0xff, 0xc0,
+    0xff, 0xff, 0xf0, // ##########
+    0xff, 0xff, 0xf0,
+    0xff, 0xff, 0xf0, // ##########
+    0xff, 0xff, 0xf0,
+    0xff, 0xff, 0xf0, // ##########
+    0xff, 0xff, 0xf0,
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+};
+static const uint8_t shot_bits[] = {
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0xf0, 0x00, // ....##....
+    0x00, 0xf0, 0x00,
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, // ..........
+    0x00, 0x00, 0x00,
+};
+
+static const TileDef tiles[] = {
+    [TILE_INVADER] = {.shape = TILE_SPRITE, .bits = invader_bits},
+    [TILE_SHIP] = {.shape = TILE_SPRITE, .bits = ship_bits},
+    [TILE_SHOT] = {.shape = TILE_SPRITE, .bits = shot_bits},
+};
+static TileMap board;
 
-static void set_cell_color(int x, int y, lv_color_t color) {
-  if (x >= 0 && x < COLS && y >= 0 && y < ROWS && grid_cells[x][y]) {
-    lv_obj_set_style_bg_color(grid_cells[x][y], color, 0);
-  }
-}
+// --- Input ---
+// Left/Right move while held; a tap shorter than a tick still moves once
+static bool left_tapped;
+static bool right_tapped;
 
 static void render_game(void) {
   // 1. Clear Grid (White)
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      set_cell_color(x, y, lv_color_white());
-    }
-  }
+  tile_map_fill(&board, TILE_EMPTY);
 
   // 2. Player
-  set_cell_color(player_x, PLAYER_Y, lv_color_black());
+  tile_map_set(&board, player_x, PLAYER_Y, TILE_SHIP);
 
   // 3. Invaders
   for (int i = 0; i < MAX_INVADERS; i++) {
     if (invaders[i].active) {
-      set_cell_color(invaders[i].x, invaders[i].y, lv_color_black());
+      tile_map_set(&board, invaders[i].x, invaders[i].y, TILE_INVADER);
     }
   }
 
-  // 4. Projectiles (Small visual tweak? No, stick to grid for artifact safety)
+  // 4. Projectiles
   for (int i = 0; i < MAX_PROJECTILES; i++) {
     if (projectiles[i].active) {
-      set_cell_color(projectiles[i].x, projectiles[i].y, lv_color_black());
+      tile_map_set(&board, projectiles[i].x, projectiles[i].y, TILE_SHOT);
     }
   }
+
+  tile_map_commit(&board);
 }
 
 static void spawn_invaders(void) {
@@ -114,7 +205,7 @@ static void reset_game(void) {
   spawn_invaders();
   invader_move_dir = 1;
   invader_move_speed = 800; // Start slow
-  last_move_tick = k_uptime_get();
+  invader_move_timer = 0;
 
   if (game_over_label)
     lv_obj_add_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
@@ -124,25 +215,16 @@ static void reset_game(void) {
   render_game();
 }
 
-static void space_invaders_enter(void) {
-  main_cont = lv_obj_create(lv_scr_act());
+static void space_invaders_enter(lv_obj_t *scr) {
+  main_cont = lv_obj_create(scr);
   lv_obj_set_size(main_cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_style_bg_color(main_cont, lv_color_white(), 0);
   lv_obj_set_scrollbar_mode(main_cont, LV_SCROLLBAR_MODE_OFF);
   lv_obj_clear_flag(main_cont, LV_OBJ_FLAG_SCROLLABLE);
 
-  // Create Static Grid
-  for (int x = 0; x < COLS; x++) {
-    for (int y = 0; y < ROWS; y++) {
-      lv_obj_t *cell = lv_obj_create(main_cont);
-      lv_obj_set_size(cell, CELL_SIZE, CELL_SIZE);
-      lv_obj_set_pos(cell, x * CELL_SIZE, y * CELL_SIZE);
-      lv_obj_set_style_border_width(cell, 0, 0);
-      lv_obj_set_style_radius(cell, 0, 0);
-      lv_obj_set_style_bg_color(cell, lv_color_white(), 0);
-      grid_cells[x][y] = cell;
-    }
-  }
+  // Board
+  tile_map_create(&board, main_cont, COLS, ROWS, CELL_SIZE, tiles,
+                  ARRAY_SIZE(tiles));
 
   // Score Label
   score_label = lv_label_create(main_cont);
@@ -158,122 +240,130 @@ static void space_invaders_enter(void) {
   lv_obj_move_foreground(game_over_label);
 
   reset_game();
-  last_tick = k_uptime_get();
 }
 
-static void space_invaders_update(void) {
-  int btn_up_curr = gpio_pin_get_dt(&btn_up);
+static void space_invaders_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
   if (game_over) {
-    if (btn_up_curr && !btn_up_prev) {
+    if (evt->button == BTN_UP) {
       reset_game();
     }
-    btn_up_prev = btn_up_curr;
     return;
   }
 
-  int64_t now = k_uptime_get();
-
-  // Input Handling (Movement - Fast Polling)
-  int btn_left_curr = gpio_pin_get_dt(&btn_left);
-  int btn_right_curr = gpio_pin_get_dt(&btn_right);
-
-  // Move Player (Throttled but responsive)
-  if ((now - last_tick > 100)) {
-    if (btn_left_curr && player_x > 0)
-      player_x--;
-    if (btn_right_curr && player_x < COLS - 1)
-      player_x++;
-  }
-
-  // Fire Projectile (Rising Edge of SELECT)
-  int btn_select_curr = gpio_pin_get_dt(&btn_select);
-  if (btn_select_curr && !btn_select_prev) {
-    // Find empty projectile slot
+  switch (evt->button) {
+  case BTN_LEFT:
+    left_tapped = true;
+    break;
+  case BTN_RIGHT:
+    right_tapped = true;
+    break;
+  case BTN_SELECT:
+    // Fire Projectile: find empty projectile slot
     for (int i = 0; i < MAX_PROJECTILES; i++) {
       if (!projectiles[i].active) {
         projectiles[i].active = true;
         projectiles[i].x = player_x;
         projectiles[i].y = PLAYER_Y - 1;
-        play_beep_move();
+        audio_play_sfx(&sfx_shot);
         break;
       }
     }
+    break;
+  default:
+    break;
   }
-  btn_select_prev = btn_select_curr;
-  btn_up_prev = btn_up_curr;
+}
 
-  // --- Game Logic (Throttled) ---
-  if (now - last_tick > 100) {
+// --- Game Logic (Fixed 100ms Tick) ---
+static void space_invaders_tick(void) {
+  if (game_over)
+    return;
 
-    // 1. Update Projectiles
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-      if (projectiles[i].active) {
-        projectiles[i].y--; // Move Up
-        if (projectiles[i].y < 0) {
-          projectiles[i].active = false; // Off screen
-        } else {
-          // Collision Check vs Invaders
-          for (int j = 0; j < MAX_INVADERS; j++) {
-            if (invaders[j].active && invaders[j].x == projectiles[i].x &&
-                invaders[j].y == projectiles[i].y) {
-              invaders[j].active = false;
-              projectiles[i].active = false;
-              score += 10;
-              play_beep_eat();
-              lv_label_set_text_fmt(score_label, "Score: %d", score);
-              break;
-            }
+  // Move Player (Held Left/Right, one cell per tick)
+  if ((left_tapped || button_held(BTN_LEFT)) && player_x > 0)
+    player_x--;
+  if ((right_tapped || button_held(BTN_RIGHT)) && player_x < COLS - 1)
+    player_x++;
+  left_tapped = false;
+  right_tapped = false;
+
+  // 1. Update Projectiles
+  for (int i = 0; i < MAX_PROJECTILES; i++) {
+    if (projectiles[i].active) {
+      projectiles[i].y--; // Move Up
+      if (projectiles[i].y < 0) {
+        projectiles[i].active = false; // Off screen
+      } else {
+        // Collision Check vs Invaders
+        for (int j = 0; j < MAX_INVADERS; j++) {
+          if (invaders[j].active && invaders[j].x == projectiles[i].x &&
+              invaders[j].y == projectiles[i].y) {
+            invaders[j].active = false;
+            projectiles[i].active = false;
+            score += 10;
+            audio_play_sfx(&sfx_invader_hit);
+            lv_label_set_text_fmt(score_label, "Score: %d", score);
+            break;
           }
         }
       }
     }
+  }
 
-    // 2. Move Invaders
-    if (now - last_move_tick > invader_move_speed) {
-      bool dir_changed = false;
-      // Check edges
-      for (int i = 0; i < MAX_INVADERS; i++) {
-        if (invaders[i].active) {
-          if (invader_move_dir == 1 && invaders[i].x >= COLS - 1) {
-            dir_changed = true;
-          } else if (invader_move_dir == -1 && invaders[i].x <= 0) {
-            dir_changed = true;
-          }
+  // 2. Move Invaders (every invader_move_speed ms worth of ticks)
+  invader_move_timer += TICK_MS;
+  if (invader_move_timer >= invader_move_speed) {
+    invader_move_timer = 0;
+
+    bool dir_changed = false;
+    // Check edges
+    for (int i = 0; i < MAX_INVADERS; i++) {
+      if (invaders[i].active) {
+        if (invader_move_dir == 1 && invaders[i].x >= COLS - 1) {
+          dir_changed = true;
+        } else if (invader_move_dir == -1 && invaders[i].x <= 0) {
+          dir_changed = true;
         }
       }
+    }
 
-      if (dir_changed) {
-        invader_move_dir = -invader_move_dir;
-        // Move Down
-        for (int i = 0; i < MAX_INVADERS; i++) {
-          if (invaders[i].active)
-            invaders[i].y++;
-          // Game Over if reach bottom
-          if (invaders[i].active && invaders[i].y >= PLAYER_Y) {
-            game_over = true;
-            lv_obj_clear_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
-          }
-        }
-        // Increase speed
-        if (invader_move_speed > 200)
-          invader_move_speed -= 50;
-
-      } else {
-        // Determine if we should move ALL or just some?
-        // Classic moves them one by one, but for Grid implementation, moving
-        // all is safer for state. Move Horizontal
-        for (int i = 0; i < MAX_INVADERS; i++) {
-          if (invaders[i].active)
-            invaders[i].x += invader_move_dir;
+    if (dir_changed) {
+      invader_move_dir = -invader_move_dir;
+      // Move Down
+      for (int i = 0; i < MAX_INVADERS; i++) {
+        if (invaders[i].active)
+          invaders[i].y++;
+        // Game Over if reach bottom
+        if (invaders[i].active && invaders[i].y >= PLAYER_Y) {
+          game_over = true;
+          lv_obj_clear_flag(game_over_label, LV_OBJ_FLAG_HIDDEN);
         }
       }
-      last_move_tick = now;
+      // Increase speed
+      if (invader_move_speed > 200)
+        invader_move_speed -= 50;
+
+    } else {
+      // Determine if we should move ALL or just some?
+      // Classic moves them one by one, but for Grid implementation, moving
+      // all is safer for state. Move Horizontal
+      for (int i = 0; i < MAX_INVADERS; i++) {
+        if (invaders[i].active)
+          invaders[i].x += invader_move_dir;
+      }
     }
-
-    render_game();
-    last_tick = now;
   }
+
+  render_game();
+}
+
+// Screen is retained, the wave continues where it was left
+static void space_invaders_resume(void) {
+  left_tapped = false;
+  right_tapped = false;
 }
 
 static void space_invaders_exit(void) {
@@ -283,7 +373,15 @@ static void space_invaders_exit(void) {
   }
 }
 
+/* Steering reads the held level every tick: no repeats or long presses */
+static const ButtonTiming space_invaders_buttons = {0};
+
 App space_invaders_app = {.name = "Space Invaders",
                           .enter = space_invaders_enter,
-                          .update = space_invaders_update,
-                          .exit = space_invaders_exit};
+                          .input = space_invaders_input,
+                          .exit = space_invaders_exit,
+                          .resume = space_invaders_resume,
+                          .tick_ms = TICK_MS,
+                          .tick = space_invaders_tick,
+                          .buttons = &space_invaders_buttons,
+                          .refresh = REFRESH_FAST};
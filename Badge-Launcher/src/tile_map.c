@@ -0,0 +1,227 @@
+#include "tile_map.h"
+
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+/* Draw stats, over every tile map drawn (launcher thread writes) */
+static uint32_t draws;
+static uint32_t cells_drawn;
+static uint32_t rects_drawn;
+static uint64_t draw_cycles;
+static uint32_t max_draw_cycles;
+static uint32_t map_bytes; // Last map created
+
+/* Commit stats */
+static uint32_t commits;
+static uint32_t cells_changed;
+static uint32_t rects_invalidated;
+
+static void draw_rect(lv_layer_t *layer, lv_draw_rect_dsc_t *dsc, int32_t x1,
+                      int32_t y1, int32_t x2, int32_t y2) {
+  lv_area_t area = {.x1 = x1, .y1 = y1, .x2 = x2, .y2 = y2};
+
+  lv_draw_rect(layer, dsc, &area);
+  rects_drawn++;
+}
+
+// Sprite rows as horizontal runs of set bits
+static void draw_sprite(lv_layer_t *layer, lv_draw_rect_dsc_t *dsc,
+                        const TileMap *map, const uint8_t *bits, int32_t x0,
+                        int32_t y0) {
+  int stride = (map->cell_size + 7) / 8;
+
+  for (int y = 0; y < map->cell_size; y++) {
+    const uint8_t *row = bits + y * stride;
+    int start = -1;
+
+    for (int x = 0; x <= map->cell_size; x++) {
+      bool set = x < map->cell_size && (row[x / 8] & (0x80 >> (x % 8)));
+
+      if (set && start < 0) {
+        start = x;
+      } else if (!set && start >= 0) {
+        draw_rect(layer, dsc, x0 + start, y0 + y, x0 + x - 1, y0 + y);
+        start = -1;
+      }
+    }
+  }
+}
+
+static void draw_cb(lv_event_t *e) {
+  const TileMap *map = lv_event_get_user_data(e);
+  lv_layer_t *layer = lv_event_get_layer(e);
+  uint32_t start = k_cycle_get_32();
+  lv_area_t coords;
+  lv_area_t clip;
+
+  lv_obj_get_coords(map->obj, &coords);
+  if (!lv_area_intersect(&clip, &coords, &layer->_clip_area))
+    return;
+
+  // Only the rows and columns that meet the area being redrawn
+  int size = map->cell_size;
+  int x_first = (clip.x1 - coords.x1) / size;
+  int x_last = MIN((clip.x2 - coords.x1) / size, map->cols - 1);
+  int y_first = (clip.y1 - coords.y1) / size;
+  int y_last = MIN((clip.y2 - coords.y1) / size, map->rows - 1);
+
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_color = lv_color_black();
+
+  for (int y = y_first; y <= y_last; y++) {
+    int32_t top = coords.y1 + y * size;
+
+    for (int x = x_first; x <= x_last; x++) {
+      uint8_t tile = map->cells[y][x];
+      if (tile == TILE_EMPTY || tile >= map->num_tiles)
+        continue;
+
+      const TileDef *def = &map->tiles[tile];
+      int32_t left = coords.x1 + x * size;
+      cells_drawn++;
+
+      if (def->shape == TILE_SPRITE) {
+        dsc.radius = 0;
+        draw_sprite(layer, &dsc, map, def->bits, left, top);
+        continue;
+      }
+
+      // A run of the same plain fill is one rectangle
+      int end = x;
+      if (def->shape == TILE_FILL && def->inset == 0) {
+        while (end < x_last && map->cells[y][end + 1] == tile) {
+          end++;
+          cells_drawn++;
+        }
+      }
+      dsc.radius = def->shape == TILE_ROUND ? LV_RADIUS_CIRCLE : 0;
+      draw_rect(layer, &dsc, left + def->inset, top + def->inset,
+                coords.x1 + (end + 1) * size - 1 - def->inset,
+                top + size - 1 - def->inset);
+      x = end;
+    }
+  }
+
+  uint32_t cycles = k_cycle_get_32() - start;
+  draws++;
+  draw_cycles += cycles;
+  max_draw_cycles = MAX(max_draw_cycles, cycles);
+}
+
+lv_obj_t *tile_map_create(TileMap *map, lv_obj_t *parent, int cols, int rows,
+                          int cell_size, const TileDef *tiles, int num_tiles) {
+  map->tiles = tiles;
+  map->num_tiles = num_tiles;
+  map->cols = MIN(cols, TILE_MAP_MAX_COLS);
+  map->rows = MIN(rows, TILE_MAP_MAX_ROWS);
+  map->cell_size = cell_size;
+  memset(map->cells, TILE_EMPTY, sizeof(map->cells));
+  memset(map->back, TILE_EMPTY, sizeof(map->back));
+
+  // A bare object: no theme styles, nothing to lay out or scroll
+  map->obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(map->obj);
+  lv_obj_set_size(map->obj, map->cols * cell_size, map->rows * cell_size);
+  lv_obj_set_pos(map->obj, 0, 0);
+  lv_obj_clear_flag(map->obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_event_cb(map->obj, draw_cb, LV_EVENT_DRAW_MAIN, map);
+
+  map_bytes = sizeof(*map);
+  return map->obj;
+}
+
+void tile_map_set(TileMap *map, int x, int y, uint8_t tile) {
+  if (x >= 0 && x < map->cols && y >= 0 && y < map->rows)
+    map->back[y][x] = tile;
+}
+
+uint8_t tile_map_get(const TileMap *map, int x, int y) {
+  if (x < 0 || x >= map->cols || y < 0 || y >= map->rows)
+    return TILE_EMPTY;
+  return map->back[y][x];
+}
+
+void tile_map_fill(TileMap *map, uint8_t tile) {
+  memset(map->back, tile, sizeof(map->back));
+}
+
+static void invalidate_cells(TileMap *map, int x1, int y1, int x2, int y2) {
+  lv_area_t area;
+  lv_obj_get_coords(map->obj, &area);
+  area.x2 = area.x1 + (x2 + 1) * map->cell_size - 1;
+  area.y2 = area.y1 + (y2 + 1) * map->cell_size - 1;
+  area.x1 += x1 * map->cell_size;
+  area.y1 += y1 * map->cell_size;
+  lv_obj_invalidate_area(map->obj, &area);
+  rects_invalidated++;
+}
+
+void tile_map_commit(TileMap *map) {
+  uint32_t dirty[TILE_MAP_MAX_ROWS] = {0}; // A bit per column
+  int changed = 0;
+
+  for (int y = 0; y < map->rows; y++) {
+    for (int x = 0; x < map->cols; x++) {
+      if (map->back[y][x] != map->cells[y][x]) {
+        map->cells[y][x] = map->back[y][x];
+        dirty[y] |= BIT(x);
+        changed++;
+      }
+    }
+  }
+  commits++;
+  if (!changed)
+    return;
+  cells_changed += changed;
+
+  // Greedy cover: take the first run of dirty cells in a row, grow it down
+  // while the rows below are dirty across the whole run
+  for (int y = 0; y < map->rows; y++) {
+    while (dirty[y]) {
+      int x1 = __builtin_ctz(dirty[y]);
+      int x2 = x1;
+      while (x2 + 1 < map->cols && (dirty[y] & BIT(x2 + 1)))
+        x2++;
+
+      uint32_t run = GENMASK(x2, x1);
+      int y2 = y;
+      while (y2 + 1 < map->rows && (dirty[y2 + 1] & run) == run)
+        y2++;
+
+      for (int r = y; r <= y2; r++)
+        dirty[r] &= ~run;
+      invalidate_cells(map, x1, y, x2, y2);
+    }
+  }
+}
+
+/* Shell: badge tiles [reset] */
+static int cmd_tiles(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Usage: badge tiles [reset]");
+      return -EINVAL;
+    }
+    draws = cells_drawn = rects_drawn = max_draw_cycles = 0;
+    draw_cycles = 0;
+    commits = cells_changed = rects_invalidated = 0;
+    return 0;
+  }
+
+  shell_print(sh, "Map: %u bytes, 1 LVGL object", map_bytes);
+  shell_print(sh, "Commits: %u, cells changed: %u, areas invalidated: %u",
+              commits, cells_changed, rects_invalidated);
+  shell_print(sh, "Draws: %u, cells: %u, rectangles: %u", draws, cells_drawn,
+              rects_drawn);
+  if (draws)
+    shell_print(sh, "Draw time: avg %u us, max %u us",
+                (uint32_t)k_cyc_to_us_ceil64(draw_cycles / draws),
+                k_cyc_to_us_ceil32(max_draw_cycles));
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), tiles, NULL,
+                 "Tile map update and draw cost\n"
+                 "Usage: badge tiles [reset]",
+                 cmd_tiles, 1, 1);
@@ -0,0 +1,59 @@
+#ifndef TILE_MAP_H
+#define TILE_MAP_H
+
+#include "app_shared.h"
+
+/*
+ * Grid games draw through a tile map: one LVGL object holding a byte per
+ * cell, painted by its own draw callback, where they used to create an
+ * lv_obj with local styles for every cell. A cell's byte indexes the game's
+ * tile set; 0 is always empty and shows the background. Tiles are drawn in
+ * black: whole cells (runs of them merge into one rectangle), circles, or
+ * 1-bpp sprites. Draw cost is on "badge tiles".
+ *
+ * Games repaint a frame into the back buffer however they like (clear it,
+ * then place everything) and call tile_map_commit(). Only cells that end up
+ * different from what is on screen are invalidated, merged into as few
+ * rectangles as a greedy pass finds, so a frame where two cells moved is a
+ * couple of small partial updates.
+ */
+#define TILE_MAP_MAX_COLS 20
+#define TILE_MAP_MAX_ROWS 15
+#define TILE_EMPTY 0
+
+typedef enum {
+  TILE_FILL,   // The cell less inset on every side
+  TILE_ROUND,  // Circle in the cell less inset
+  TILE_SPRITE, // bits: a row per pixel, (cell + 7) / 8 bytes, MSB first
+} TileShape;
+
+typedef struct {
+  uint8_t shape; // TileShape
+  uint8_t inset; // Background px kept around FILL and ROUND
+  const uint8_t *bits;
+} TileDef;
+
+typedef struct {
+  lv_obj_t *obj;
+  const TileDef *tiles; // Indexed by cell value, [TILE_EMPTY] unused
+  uint8_t num_tiles;
+  uint8_t cols;
+  uint8_t rows;
+  uint8_t cell_size; // px
+  uint8_t cells[TILE_MAP_MAX_ROWS][TILE_MAP_MAX_COLS]; // On screen
+  uint8_t back[TILE_MAP_MAX_ROWS][TILE_MAP_MAX_COLS];  // Next frame
+} TileMap;
+
+/* Creates the widget at the parent's top left, every cell empty */
+lv_obj_t *tile_map_create(TileMap *map, lv_obj_t *parent, int cols, int rows,
+                          int cell_size, const TileDef *tiles, int num_tiles);
+
+/* Back buffer access. Out of range cells are ignored (reads give TILE_EMPTY) */
+void tile_map_set(TileMap *map, int x, int y, uint8_t tile);
+uint8_t tile_map_get(const TileMap *map, int x, int y);
+void tile_map_fill(TileMap *map, uint8_t tile);
+
+/* Puts the back buffer on screen, invalidating only the cells that changed */
+void tile_map_commit(TileMap *map);
+
+#endif
@@ -37,11 +37,10 @@ static void update_display(void) {
   }
 }
 
-static void timer_enter(void) {
-  lv_obj_clean(lv_scr_act());
+static void timer_enter(lv_obj_t *scr) {
 
   // Main Container
-  lv_obj_t *cont = lv_obj_create(lv_scr_act());
+  lv_obj_t *cont = lv_obj_create(scr);
   lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
   lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
   lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER,
@@ -69,48 +68,45 @@ static void timer_enter(void) {
   // Actually, for a simple app refactor, let's just re-init variables if you
   // want a fresh start. But usually timers are useful if they persist. Let's
   // keep state global but reset last_tick.
-  last_tick = k_uptime_get();
+  last_tick = app_uptime_get();
   update_display();
 }
 
-static void timer_update(void) {
-  static int select_prev = 0;
-  static int up_prev = 0;
-  static int down_prev = 0;
-
-  int select = gpio_pin_get_dt(&btn_select);
-  int up = gpio_pin_get_dt(&btn_up);
-  int down = gpio_pin_get_dt(&btn_down);
-  int left = gpio_pin_get_dt(&btn_left);
+static void timer_input(const ButtonEvent *evt) {
+  if (evt->action != BTN_PRESSED)
+    return;
 
+  switch (evt->button) {
   // EXIT
-  if (left) { // Exit immediately on left press
+  case BTN_LEFT: // Exit immediately on left press
     // State is preserved in static vars if we come back
     return_to_menu();
-    return;
-  }
+    break;
 
   // TOGGLE (Select)
-  if (select && !select_prev) {
+  case BTN_SELECT:
     running = !running;
-    last_tick = k_uptime_get(); // Reset tick delta reference
+    last_tick = app_uptime_get(); // Reset tick delta reference
     update_display();
-  }
+    break;
 
   // RESET (Up or Down)
-  if ((up && !up_prev) || (down && !down_prev)) {
+  case BTN_UP:
+  case BTN_DOWN:
     total_elapsed_ms = 0;
     running = false; // Usually reset stops it too? Or just resets count loops?
                      // "Clears it" implies 0. Let's Stop it too.
     update_display();
-  }
+    break;
 
-  select_prev = select;
-  up_prev = up;
-  down_prev = down;
+  default:
+    break;
+  }
+}
 
+static void timer_update(void) {
   // Time Accumulation
-  int64_t now = k_uptime_get();
+  int64_t now = app_uptime_get();
   if (running) {
     int64_t delta = now - last_tick;
     total_elapsed_ms += delta;
@@ -120,6 +116,9 @@ static void timer_update(void) {
     // We should throttle display updates if loop is super fast,
     // but typical LVGL loop is fine.
     update_display();
+
+    // Next wake when the seconds digit rolls over
+    request_update_in(1000 - (total_elapsed_ms % 1000));
   }
   last_tick = now;
 }
@@ -131,4 +130,5 @@ static void timer_exit(void) {
 App timer_app = {.name = "Timer",
                  .enter = timer_enter,
                  .update = timer_update,
+                 .input = timer_input,
                  .exit = timer_exit};
@@ -0,0 +1,296 @@
+#include "tone.h"
+#include "audio.h"
+#include "mixer.h"
+
+#include <stdlib.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_DECLARE(badge_launcher);
+
+static bool ready;
+static uint32_t playing_ns; // Last period handed to the backend
+static uint8_t duty = 50;   // Percent high for the next tone, 0 = silent
+static uint8_t playing_duty;
+static uint32_t produced_ns; // Last tone the backend actually made
+
+/* Duty for 0%, 10%, ... 100% of full volume: asin(gain) / pi */
+static const uint8_t gain_duty[11] = {0, 3, 6, 10, 13, 17, 20, 25, 30, 36, 50};
+
+int tone_init(void) {
+  int rc = tone_backend_init();
+
+  if (rc < 0) {
+    LOG_ERR("Tone backend %s unavailable (%d)", tone_backend_name, rc);
+    return rc;
+  }
+  ready = true;
+  return 0;
+}
+
+bool tone_ready(void) { return ready; }
+
+static uint32_t hz_to_ns(uint32_t freq_hz) {
+  return freq_hz ? NSEC_PER_SEC / freq_hz : 0;
+}
+
+uint32_t tone_start_ns(uint32_t period_ns) {
+  if (period_ns < TONE_MIN_PERIOD_NS || period_ns > TONE_MAX_PERIOD_NS)
+    period_ns = 0;
+  if (!ready)
+    return 0;
+
+  if (!duty)
+    period_ns = 0;
+  tone_probe_note(period_ns);
+  playing_ns = period_ns;
+  playing_duty = duty;
+
+  uint32_t actual_ns = tone_backend_set(period_ns, duty);
+  if (actual_ns)
+    produced_ns = actual_ns;
+  return actual_ns;
+}
+
+uint32_t tone_start(uint32_t freq_hz) {
+  return tone_start_ns(hz_to_ns(freq_hz));
+}
+
+void tone_stop(void) { tone_start_ns(0); }
+
+uint32_t tone_retune_ns(uint32_t period_ns) {
+  if (period_ns < TONE_MIN_PERIOD_NS || period_ns > TONE_MAX_PERIOD_NS ||
+      !duty || !playing_ns || !ready)
+    return tone_start_ns(period_ns);
+
+  // Same note carrying on for the probe, only its period moves
+  playing_ns = period_ns;
+  playing_duty = duty;
+
+  uint32_t actual_ns = tone_backend_retune(period_ns, duty);
+  if (actual_ns)
+    produced_ns = actual_ns;
+  return actual_ns;
+}
+
+void tone_set_gain(uint8_t percent) {
+  int step = MIN(percent, 100) / 10;
+  int lo = gain_duty[step];
+  int hi = gain_duty[MIN(step + 1, 10)];
+
+  duty = lo + (hi - lo) * (MIN(percent, 100) % 10) / 10;
+}
+
+void tone_play_ns(uint32_t period_ns, uint32_t duration_us) {
+#ifdef CONFIG_BADGE_TONE_BUSY
+  if (ready) {
+    if (duty && period_ns)
+      produced_ns = period_ns; // To the cycle
+    tone_backend_play(duty ? period_ns : 0, duty, duration_us);
+    return;
+  }
+#else
+  if (period_ns != playing_ns || duty != playing_duty)
+    tone_retune_ns(period_ns);
+#endif
+  k_usleep(duration_us);
+}
+
+void tone_play_us(uint32_t freq_hz, uint32_t duration_us) {
+  tone_play_ns(hz_to_ns(freq_hz), duration_us);
+}
+
+/* Probe */
+static struct k_spinlock probe_lock;
+static bool probe_armed;
+static ToneProbeStats probe_stats;
+static uint64_t pitch_sum; // ppm, over measured notes
+static uint64_t duty_sum;
+static uint32_t onsets[TONE_PROBE_NOTES];
+static uint32_t edge_log[TONE_PROBE_EDGES]; // Rising edges
+static uint16_t edge_count;
+
+/* The note being measured */
+static uint32_t note_ns;  // Requested period, 0 = silence
+static uint8_t note_duty; // Requested percent high
+static uint32_t note_at; // Cycle of the note change
+static uint32_t edges;
+static uint32_t last_edge;
+static uint32_t last_half; // Cycles between the last two edges
+static bool last_half_high;
+static bool last_level;
+static uint64_t high_cycles;
+static uint64_t low_cycles;
+
+static void log_onset(uint32_t cycles) {
+  if (probe_stats.notes < TONE_PROBE_NOTES)
+    onsets[probe_stats.notes++] = cycles;
+}
+
+static uint32_t ppm_off(uint64_t value, uint64_t target) {
+  uint64_t off = value > target ? value - target : target - value;
+  return target ? MIN(off * 1000000 / target, UINT32_MAX) : 0;
+}
+
+static void close_note(void) {
+  if (note_ns && edges == 0)
+    log_onset(note_at); // Nothing to time it by but the change itself
+  if (!note_ns || edges < 3)
+    return;
+
+  // Whole periods only, an odd half would weigh one level twice
+  uint32_t halves = edges - 1;
+  if (halves % 2) {
+    if (last_half_high)
+      high_cycles -= last_half;
+    else
+      low_cycles -= last_half;
+    halves--;
+  }
+
+  uint64_t span = high_cycles + low_cycles;
+  uint64_t hz = sys_clock_hw_cycles_per_sec();
+  uint64_t measured_ns = span * NSEC_PER_SEC * 2 / halves / hz;
+  uint32_t pitch = ppm_off(measured_ns, note_ns);
+  uint32_t duty_off = (uint64_t)ppm_off(high_cycles * 100, span * note_duty) *
+                      note_duty / 100;
+
+  probe_stats.measured++;
+  probe_stats.pitch_max_ppm = MAX(probe_stats.pitch_max_ppm, pitch);
+  probe_stats.duty_max_ppm = MAX(probe_stats.duty_max_ppm, duty_off);
+  pitch_sum += pitch;
+  duty_sum += duty_off;
+}
+
+void tone_probe_note(uint32_t period_ns) {
+  k_spinlock_key_t key = k_spin_lock(&probe_lock);
+
+  if (probe_armed) {
+    close_note();
+    note_ns = period_ns;
+    note_duty = duty;
+    note_at = k_cycle_get_32();
+    edges = 0;
+    high_cycles = low_cycles = 0;
+  }
+  k_spin_unlock(&probe_lock, key);
+}
+
+void tone_probe_edge(bool level) {
+  if (!probe_armed)
+    return;
+
+  uint32_t now = k_cycle_get_32();
+  k_spinlock_key_t key = k_spin_lock(&probe_lock);
+
+  if (level && edge_count < TONE_PROBE_EDGES)
+    edge_log[edge_count++] = now;
+  if (!note_ns) {
+    k_spin_unlock(&probe_lock, key);
+    return;
+  }
+  if (edges == 0) {
+    log_onset(now);
+  } else {
+    last_half = now - last_edge;
+    last_half_high = last_level;
+    if (last_level)
+      high_cycles += last_half;
+    else
+      low_cycles += last_half;
+  }
+  last_edge = now;
+  last_level = level;
+  edges++;
+  k_spin_unlock(&probe_lock, key);
+}
+
+void tone_probe_arm(void) {
+  k_spinlock_key_t key = k_spin_lock(&probe_lock);
+
+  probe_stats = (ToneProbeStats){0};
+  pitch_sum = duty_sum = 0;
+  note_ns = 0;
+  edge_count = 0;
+  probe_armed = true;
+  k_spin_unlock(&probe_lock, key);
+}
+
+void tone_probe_disarm(ToneProbeStats *stats) {
+  k_spinlock_key_t key = k_spin_lock(&probe_lock);
+
+  close_note();
+  probe_armed = false;
+  note_ns = 0;
+  if (probe_stats.measured) {
+    probe_stats.pitch_avg_ppm = pitch_sum / probe_stats.measured;
+    probe_stats.duty_avg_ppm = duty_sum / probe_stats.measured;
+  }
+  *stats = probe_stats;
+  k_spin_unlock(&probe_lock, key);
+}
+
+const uint32_t *tone_probe_onsets(void) { return onsets; }
+
+const uint32_t *tone_probe_edges(uint16_t *count) {
+  *count = edge_count;
+  return edge_log;
+}
+
+/* Shell: badge tone <hz> [ms] */
+static bool on_mixer(void) {
+#ifdef CONFIG_BADGE_MIXER
+  return mixer_ready();
+#else
+  return false;
+#endif
+}
+
+static int cmd_tone(const struct shell *sh, size_t argc, char **argv) {
+  if (argc < 2) {
+    shell_print(sh, "Backend: %s (%s), playing: %u ns period, %u%% duty",
+                tone_backend_name, ready ? "ready" : "unavailable",
+                playing_ns, playing_duty);
+    return 0;
+  }
+
+  uint32_t hz = strtoul(argv[1], NULL, 0);
+  uint32_t ms = argc > 2 ? strtoul(argv[2], NULL, 0) : 500;
+
+  if (!ready) {
+    shell_error(sh, "Tone backend %s unavailable", tone_backend_name);
+    return -ENODEV;
+  }
+  if (hz < TONE_MIN_HZ || hz > TONE_MAX_HZ || ms < 1 || ms > 10000) {
+    shell_error(sh, "Usage: badge tone <%d-%d hz> [1-10000 ms]", TONE_MIN_HZ,
+                TONE_MAX_HZ);
+    return -EINVAL;
+  }
+  if (audio_muted() || !audio_level(AUDIO_SFX)) {
+    shell_error(sh, "Sound is muted or sfx is at level 0");
+    return -EPERM;
+  }
+
+  // Played by the audio thread, which owns the buzzer
+  produced_ns = 0;
+  if (!audio_request_tone(hz, ms)) {
+    shell_error(sh, "The launcher did not pick the tone up");
+    return -ETIMEDOUT;
+  }
+  k_msleep((ms + 1) / 2); // Sampled midway, music may follow the effect
+  uint32_t actual_ns = produced_ns;
+  k_msleep(ms / 2);
+
+  if (on_mixer()) {
+    shell_print(sh, "mixer: played %u Hz on the effects channel", hz);
+    return 0;
+  }
+  uint32_t actual_mhz = actual_ns ? 1000ULL * NSEC_PER_SEC / actual_ns : 0;
+
+  shell_print(sh, "%s: asked %u Hz, produced %u.%03u Hz", tone_backend_name,
+              hz, actual_mhz / 1000, actual_mhz % 1000);
+  return 0;
+}
+
+SHELL_SUBCMD_ADD((badge), tone, NULL,
+                 "Play a test tone on the buzzer\nUsage: badge tone [hz] [ms]",
+                 cmd_tone, 1, 2);
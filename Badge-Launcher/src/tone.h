@@ -0,0 +1,102 @@
+#ifndef TONE_H
+#define TONE_H
+
+#include "app_shared.h"
+
+/*
+ * Square-wave tone output on the buzzer. One backend is built in,
+ * chosen by Kconfig (BADGE_TONE_BACKEND):
+ *   pwm   - a PWM channel drives the pin, no CPU cost while a tone plays
+ *   timer - a counter (or kernel timer) interrupt toggles the buzzer GPIO
+ *   busy  - the calling thread bit-bangs the GPIO, the old behaviour
+ * PWM and timer are asynchronous: tone_start() returns with the tone
+ * running. Try one out with "badge tone".
+ */
+#define TONE_MIN_HZ 20
+#define TONE_MAX_HZ 20000
+
+#define TONE_MIN_PERIOD_NS (NSEC_PER_SEC / TONE_MAX_HZ)
+#define TONE_MAX_PERIOD_NS (NSEC_PER_SEC / TONE_MIN_HZ)
+
+/* Configures the buzzer for the backend, called once at boot */
+int tone_init(void);
+bool tone_ready(void);
+
+/*
+ * Starts (or retunes) a tone of the given period and returns at once;
+ * periods outside TONE_MIN_PERIOD_NS..TONE_MAX_PERIOD_NS are silence.
+ * Returns the period the backend actually produces, 0 if silent. Busy-loop
+ * builds only remember the period, the sound comes from tone_play_ns().
+ */
+uint32_t tone_start_ns(uint32_t period_ns);
+uint32_t tone_start(uint32_t freq_hz);
+void tone_stop(void);
+
+/*
+ * Glides a sounding tone to a new period from its next edge, without
+ * stopping it or resetting its phase, for sweeps retuned every few
+ * milliseconds. Starts the tone if it is silent. Returns as tone_start_ns().
+ */
+uint32_t tone_retune_ns(uint32_t period_ns);
+
+/*
+ * Sounds a tone for duration_us. Asynchronous backends retune the running
+ * tone (tone_retune_ns()), sleep and leave it running, so back-to-back notes
+ * join without a gap; end with tone_stop(). Busy-loop builds play whole
+ * periods only, so a duration under one period plays a single one. Song
+ * notes come with their period precomputed, so playing them needs no
+ * division.
+ */
+void tone_play_ns(uint32_t period_ns, uint32_t duration_us);
+void tone_play_us(uint32_t freq_hz, uint32_t duration_us);
+
+/*
+ * Volume on a one-bit buzzer is pulse width: the fundamental of a pulse
+ * wave goes as sin(pi * duty), so a square wave is loudest and narrower
+ * pulses are quieter. Sets the duty for percent of full volume (0 is
+ * silence), applied from the next tone started.
+ */
+void tone_set_gain(uint8_t percent);
+
+/*
+ * Probe for "badge music bench" and "badge audio bench". While armed,
+ * backends report every buzzer edge and tone_start_ns() every note change.
+ * Each note's pitch and duty are measured from its edges, and its onset
+ * (first edge, or the note change when no edges come, as with PWM or the
+ * mixer) is logged in cycles. The first TONE_PROBE_EDGES rising edges are
+ * logged in cycles too, notes or not, for sweeps that never change note.
+ */
+#define TONE_PROBE_NOTES 512
+#define TONE_PROBE_EDGES 256
+
+typedef struct {
+  uint16_t notes;    // Onsets logged
+  uint16_t measured; // Notes with edges enough for pitch and duty
+  uint32_t pitch_avg_ppm;
+  uint32_t pitch_max_ppm;
+  uint32_t duty_avg_ppm; // Off the set duty, per million of the period
+  uint32_t duty_max_ppm;
+} ToneProbeStats;
+
+void tone_probe_arm(void);
+void tone_probe_disarm(ToneProbeStats *stats);
+const uint32_t *tone_probe_onsets(void);
+const uint32_t *tone_probe_edges(uint16_t *count);
+void tone_probe_note(uint32_t period_ns); // 0 = silence
+void tone_probe_edge(bool level);         // ISR-safe
+
+/*
+ * Backend interface (tone_pwm.c, tone_timer.c, tone_busy.c). Duty is the
+ * percent of the period spent high, 1-99; a period of 0 is silence.
+ * tone_backend_set() starts the wave afresh; tone_backend_retune() changes
+ * the period of a running one (never 0) from its next edge.
+ */
+extern const char tone_backend_name[];
+int tone_backend_init(void);
+uint32_t tone_backend_set(uint32_t period_ns, uint8_t duty); // Actual period
+uint32_t tone_backend_retune(uint32_t period_ns, uint8_t duty);
+#ifdef CONFIG_BADGE_TONE_BUSY
+void tone_backend_play(uint32_t period_ns, uint8_t duty, uint32_t duration_us);
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+#include "tone.h"
+
+/*
+ * Bit-banged from the calling thread. Edges are scheduled against absolute
+ * cycle deadlines, so a late wakeup shortens the next half period instead
+ * of flattening the pitch, but the thread is busy for the whole note.
+ */
+const char tone_backend_name[] = "busy";
+
+int tone_backend_init(void) {
+  if (!gpio_is_ready_dt(&buzzer))
+    return -ENODEV;
+  return gpio_pin_configure_dt(&buzzer, GPIO_OUTPUT_INACTIVE);
+}
+
+uint32_t tone_backend_set(uint32_t period_ns, uint8_t duty) {
+  gpio_pin_set_dt(&buzzer, 0);
+  return period_ns; // Sounds in tone_backend_play()
+}
+
+uint32_t tone_backend_retune(uint32_t period_ns, uint8_t duty) {
+  return period_ns; // Nothing running to retune
+}
+
+void tone_backend_play(uint32_t period_ns, uint8_t duty, uint32_t duration_us) {
+  if (period_ns < TONE_MIN_PERIOD_NS || period_ns > TONE_MAX_PERIOD_NS) {
+    k_usleep(duration_us);
+    return;
+  }
+
+  uint64_t high = k_ns_to_cyc_near64((uint64_t)period_ns * duty / 100);
+  uint64_t low = k_ns_to_cyc_near64(period_ns) - high;
+  uint64_t edge = k_cycle_get_64();
+  uint64_t end = edge + k_us_to_cyc_ceil64(duration_us);
+  bool level = false;
+
+  while (edge < end) {
+    level = !level;
+    gpio_pin_set_dt(&buzzer, level);
+    tone_probe_edge(level);
+    edge += level ? high : low;
+
+    int64_t wait = edge - k_cycle_get_64();
+    if (wait > 0)
+      k_usleep(k_cyc_to_us_floor32(wait));
+  }
+  gpio_pin_set_dt(&buzzer, 0);
+}
@@ -0,0 +1,30 @@
+#include "tone.h"
+
+#include <zephyr/drivers/pwm.h>
+
+/* buzzer-pwm alias: a pwm-leds child on the buzzer pin (see app.overlay) */
+static const struct pwm_dt_spec pwm = PWM_DT_SPEC_GET(DT_ALIAS(buzzer_pwm));
+
+const char tone_backend_name[] = "pwm";
+
+int tone_backend_init(void) {
+  if (!pwm_is_ready_dt(&pwm))
+    return -ENODEV;
+  return pwm_set_pulse_dt(&pwm, 0);
+}
+
+uint32_t tone_backend_set(uint32_t period_ns, uint8_t duty) {
+  if (period_ns == 0) {
+    pwm_set_pulse_dt(&pwm, 0);
+    return 0;
+  }
+
+  if (pwm_set_dt(&pwm, period_ns, (uint64_t)period_ns * duty / 100) < 0)
+    return 0;
+  return period_ns;
+}
+
+// The PWM takes a new period at the end of the current one
+uint32_t tone_backend_retune(uint32_t period_ns, uint8_t duty) {
+  return tone_backend_set(period_ns, duty);
+}
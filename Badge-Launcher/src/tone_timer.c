@@ -0,0 +1,152 @@
+#include "tone.h"
+
+#include <zephyr/drivers/counter.h>
+
+/*
+ * The buzzer GPIO is flipped from an interrupt, every half period for a
+ * square wave. With a tone-counter alias the interval is counted by that
+ * hardware timer, otherwise a kernel timer does it, rounded to whole system
+ * ticks and re-armed at every edge. Other duties alternate a high and a low
+ * interval, re-armed from the interrupt. A retune only swaps the intervals,
+ * which the interrupt picks up at the next edge: the wave carries on with no
+ * stop and no reset.
+ */
+#if defined(CONFIG_COUNTER) && DT_HAS_ALIAS(tone_counter)
+#define USE_COUNTER 1
+static const struct device *const counter =
+    DEVICE_DT_GET(DT_ALIAS(tone_counter));
+#endif
+
+const char tone_backend_name[] = "timer";
+
+static bool level;
+static uint32_t high_ticks; // Time spent at each level, equal when square
+static uint32_t low_ticks;
+static struct k_spinlock lock; // Intervals against the interrupt
+
+static void toggle(void) {
+  level = !level;
+  gpio_pin_set_dt(&buzzer, level);
+  tone_probe_edge(level);
+}
+
+static void silence(void) {
+  level = false;
+  gpio_pin_set_dt(&buzzer, 0);
+}
+
+// Splits a period in 1/100 ticks at duty percent, each side to nearest
+static void split(uint64_t centiticks, uint8_t duty, uint32_t *high,
+                  uint32_t *low) {
+  *high = MAX((centiticks * duty / 100 + 50) / 100, 1);
+  *low = MAX((centiticks * (100 - duty) / 100 + 50) / 100, 1);
+}
+
+#ifdef USE_COUNTER
+static bool retuned; // New intervals for the interrupt to load
+
+static void top_fn(const struct device *dev, void *user_data) {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+
+  toggle();
+  if (high_ticks != low_ticks || retuned) {
+    // Just wrapped, so the new top is still ahead of the count
+    struct counter_top_cfg top = {
+        .ticks = level ? high_ticks : low_ticks,
+        .callback = top_fn,
+        .flags = COUNTER_TOP_CFG_DONT_RESET | COUNTER_TOP_CFG_RESET_WHEN_LATE,
+    };
+    counter_set_top_value(dev, &top);
+    retuned = false;
+  }
+  k_spin_unlock(&lock, key);
+}
+
+int tone_backend_init(void) {
+  if (!gpio_is_ready_dt(&buzzer) || !device_is_ready(counter))
+    return -ENODEV;
+  return gpio_pin_configure_dt(&buzzer, GPIO_OUTPUT_INACTIVE);
+}
+
+uint32_t tone_backend_set(uint32_t period_ns, uint8_t duty) {
+  counter_stop(counter);
+  silence();
+  if (period_ns == 0)
+    return 0;
+
+  uint64_t clock_hz = counter_get_frequency(counter);
+  split(period_ns * clock_hz * 100 / NSEC_PER_SEC, duty, &high_ticks,
+        &low_ticks);
+  retuned = false;
+
+  // Low first: the first edge goes high
+  struct counter_top_cfg top = {
+      .ticks = low_ticks,
+      .callback = top_fn,
+  };
+
+  if (counter_set_top_value(counter, &top) < 0 || counter_start(counter) < 0)
+    return 0;
+  return (uint64_t)(high_ticks + low_ticks) * NSEC_PER_SEC / clock_hz;
+}
+
+uint32_t tone_backend_retune(uint32_t period_ns, uint8_t duty) {
+  uint64_t clock_hz = counter_get_frequency(counter);
+  uint32_t high, low;
+
+  split(period_ns * clock_hz * 100 / NSEC_PER_SEC, duty, &high, &low);
+
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  high_ticks = high;
+  low_ticks = low;
+  retuned = true; // Loaded as the top at the next wrap
+  k_spin_unlock(&lock, key);
+  return (uint64_t)(high + low) * NSEC_PER_SEC / clock_hz;
+}
+#else
+static int64_t next_edge; // Absolute tick
+
+static void toggle_fn(struct k_timer *timer) {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+
+  // Re-armed at every edge with the intervals in force, so a retune takes
+  // over from the next one. Absolute deadlines: a relative restart would
+  // round each leg up a tick.
+  toggle();
+  next_edge += level ? high_ticks : low_ticks;
+  k_timer_start(timer, K_TIMEOUT_ABS_TICKS(next_edge), K_NO_WAIT);
+  k_spin_unlock(&lock, key);
+}
+K_TIMER_DEFINE(tone_timer, toggle_fn, NULL);
+
+int tone_backend_init(void) {
+  if (!gpio_is_ready_dt(&buzzer))
+    return -ENODEV;
+  return gpio_pin_configure_dt(&buzzer, GPIO_OUTPUT_INACTIVE);
+}
+
+uint32_t tone_backend_set(uint32_t period_ns, uint8_t duty) {
+  k_timer_stop(&tone_timer);
+  silence();
+  if (period_ns == 0)
+    return 0;
+
+  split(k_ns_to_ticks_near64((uint64_t)period_ns * 100), duty, &high_ticks,
+        &low_ticks);
+  next_edge = sys_clock_tick_get() + low_ticks;
+  k_timer_start(&tone_timer, K_TIMEOUT_ABS_TICKS(next_edge), K_NO_WAIT);
+  return k_ticks_to_ns_near64(high_ticks + low_ticks);
+}
+
+uint32_t tone_backend_retune(uint32_t period_ns, uint8_t duty) {
+  uint32_t high, low;
+
+  split(k_ns_to_ticks_near64((uint64_t)period_ns * 100), duty, &high, &low);
+
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  high_ticks = high;
+  low_ticks = low;
+  k_spin_unlock(&lock, key);
+  return k_ticks_to_ns_near64(high + low);
+}
+#endif
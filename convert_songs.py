@@ -0,0 +1,494 @@
+"""Converts RTTTL and MIDI songs into Chip Tunez song tables.
+
+Run by Badge-Launcher/CMakeLists.txt on every file in Badge-Launcher/songs/,
+in file name order:
+
+    convert_songs.py output.c song.rtttl|song.mid...
+
+A .rtttl file holds one RTTTL string per line ('#' starts a comment line).
+Note names use scientific pitch, a4 = 440 Hz, and any octave from 0 to 8 or
+duration divisor is accepted. In a .mid file every channel of every track
+becomes one mixer track, at most three melodic ones plus the drums
+(channel 10), which play on the noise channel; overlapping notes within a
+track play the most recent one. The output is the packed format described in
+Badge-Launcher/src/song.h: repeated runs of notes become patterns shared by
+all tracks of a song, note periods are precomputed in nanoseconds, and the
+songs[] registry lists every input.
+"""
+
+import os
+import re
+import struct
+import sys
+
+MAX_DURATIONS = 64  # Duration codes per song
+MAX_LOOP = 15
+MIN_PATTERN = 4  # Notes in the shortest shared pattern
+MAX_PATTERN = 64  # ...and the longest considered
+
+SONG_DUR = 0x80
+SONG_LOOP = 0xE0
+SONG_LOOP_END = 0xF0
+SONG_END = 0xFF
+SONG_REPEAT = 0x80
+
+REST = 0
+MAX_VOICES = 3  # Square voices in the mixer, plus one noise channel
+DRUM_CHANNEL = 9
+
+RTTTL_NOTES = {'c': 0, 'd': 2, 'e': 4, 'f': 5, 'g': 7, 'a': 9, 'b': 11, 'h': 11}
+
+
+def fail(msg):
+    print(f"convert_songs.py: {msg}", file=sys.stderr)
+    sys.exit(1)
+
+
+def from_times(events):
+    """[(note, start_ms, end_ms)] with float times -> [(note, ms)].
+    Rounding absolute times keeps long songs from drifting."""
+    notes = []
+    for note, start, end in events:
+        ms = round(end) - round(start)
+        if ms <= 0:
+            continue
+        if notes and notes[-1][0] == REST and note == REST:
+            notes[-1] = (REST, notes[-1][1] + ms)
+        else:
+            notes.append((note, ms))
+    return notes
+
+
+# --- RTTTL ---
+
+def parse_rtttl(line, path):
+    try:
+        name, defaults, body = line.split(':')
+    except ValueError:
+        fail(f"{path}: expected name:defaults:notes")
+
+    settings = {'d': 4, 'o': 6, 'b': 63}
+    for item in filter(None, defaults.replace(' ', '').split(',')):
+        key, _, value = item.partition('=')
+        if key not in settings or not value.isdigit():
+            fail(f"{path}: bad default '{item}'")
+        settings[key] = int(value)
+
+    whole_ms = 240000 / settings['b']
+    events, t = [], 0.0
+    for token in filter(None, body.replace(' ', '').lower().split(',')):
+        m = re.fullmatch(r'(\d+)?([a-hp])(#?)(\.?)(\d)?(\.?)', token)
+        if not m:
+            fail(f"{path}: bad note '{token}'")
+        divisor = int(m.group(1) or settings['d'])
+        ms = whole_ms / divisor * (1.5 if m.group(4) or m.group(6) else 1)
+
+        if m.group(2) == 'p':
+            note = REST
+        else:
+            octave = int(m.group(5) or settings['o'])
+            note = 12 * (octave + 1) + RTTTL_NOTES[m.group(2)]
+            note += 1 if m.group(3) else 0
+        events.append((note, t, t + ms))
+        t += ms
+    return name.strip(), from_times(events)
+
+
+# --- MIDI ---
+
+def read_vlq(data, pos):
+    value = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value = (value << 7) | (byte & 0x7F)
+        if not byte & 0x80:
+            return value, pos
+
+
+def parse_midi(data, path):
+    if data[:4] != b'MThd':
+        fail(f"{path}: not a MIDI file")
+    _, ntracks, division = struct.unpack('>HHH', data[8:14])
+    if division & 0x8000:
+        fail(f"{path}: SMPTE time division is not supported")
+
+    pos = 8 + struct.unpack('>I', data[4:8])[0]
+    tempos, tracks = [(0, 500000)], []
+    for _ in range(ntracks):
+        if data[pos:pos + 4] != b'MTrk':
+            fail(f"{path}: bad track header")
+        end = pos + 8 + struct.unpack('>I', data[pos + 4:pos + 8])[0]
+        pos += 8
+        tick, status, name, notes, last = 0, 0, None, [], 0
+        while pos < end:
+            delta, pos = read_vlq(data, pos)
+            tick += delta
+            if data[pos] & 0x80:
+                status = data[pos]
+                pos += 1
+            kind = status & 0xF0
+            if status == 0xFF:
+                meta = data[pos]
+                length, pos = read_vlq(data, pos + 1)
+                if meta == 0x51:
+                    tempos.append((tick, int.from_bytes(data[pos:pos + 3],
+                                                        'big')))
+                elif meta == 0x03:
+                    name = data[pos:pos + length].decode('latin-1')
+                elif meta == 0x2F:
+                    last = tick
+                pos += length
+            elif status in (0xF0, 0xF7):
+                length, pos = read_vlq(data, pos)
+                pos += length
+            elif kind in (0x80, 0x90):
+                key, velocity = data[pos], data[pos + 1]
+                notes.append((tick, key, kind == 0x90 and velocity > 0,
+                              status & 0x0F))
+                pos += 2
+            elif kind in (0xC0, 0xD0):
+                pos += 1
+            else:
+                pos += 2
+        tracks.append((name, notes, last))
+
+    tempos.sort(key=lambda t: t[0])  # Stable: the default stays first
+
+    def to_ms(tick):
+        ms, last_tick, tempo = 0.0, 0, 500000
+        for at, value in tempos:
+            if at >= tick:
+                break
+            ms += (at - last_tick) * tempo / division / 1000
+            last_tick, tempo = at, value
+        return ms + (tick - last_tick) * tempo / division / 1000
+
+    # Every channel of every track is a voice, channel 10 is drums
+    voices, drums, title = [], None, None
+    for name, notes, last in tracks:
+        title = title or name
+        for channel in sorted({n[3] for n in notes}):
+            keys = [n for n in notes if n[3] == channel]
+            voice = monophonic(keys, last, to_ms)
+            if channel != DRUM_CHANNEL:
+                voices.append(voice)
+            elif drums is None:
+                drums = voice
+            else:
+                fail(f"{path}: drums on more than one track")
+    if not voices and drums is None:
+        fail(f"{path}: no notes")
+    if len(voices) > MAX_VOICES:
+        fail(f"{path}: {len(voices)} melodic voices, the mixer has "
+             f"{MAX_VOICES}")
+
+    if drums is None:
+        return title, voices, -1
+    return title, voices + [drums], len(voices)
+
+
+def monophonic(keys, last, to_ms):
+    """Most recent held key sounds; silence between keys becomes a rest"""
+    events, held, sounding, since = [], [], REST, None
+    for tick, key, on, _ in sorted(keys, key=lambda n: (n[0], n[2])):
+        if on:
+            held.append(key)
+        elif key in held:
+            held.remove(key)
+        now = held[-1] if held else REST
+        if now != sounding:
+            if since is not None:
+                events.append((sounding, to_ms(since), to_ms(tick)))
+            sounding, since = now, tick
+    # A late end of track is a closing rest
+    if since is not None and last > since:
+        events.append((REST, to_ms(since), to_ms(last)))
+    return from_times(events)
+
+
+# --- Packing ---
+
+def quantize(tracks):
+    """Rounds durations until a song needs at most MAX_DURATIONS codes.
+    Note ends snap to the grid, so the tracks stay in step."""
+    for step in (1, 5, 10, 20, 25, 50, 100):
+        snapped = []
+        for notes in tracks:
+            out, at, end = [], 0, 0
+            for n, ms in notes:
+                at += ms
+                ms = round(at / step) * step - end
+                if ms > 0:
+                    out.append((n, ms))
+                    end += ms
+            snapped.append(out)
+        if len({ms for t in snapped for _, ms in t}) <= MAX_DURATIONS:
+            return snapped
+    fail("too many distinct note lengths")
+
+
+def find_patterns(notes):
+    """Splits a song into shared patterns. Returns (patterns, order)."""
+    symbols = {}
+    text = ''.join(chr(symbols.setdefault(n, len(symbols))) for n in notes)
+    tokens = {chr(i): n for n, i in symbols.items()}
+
+    # Segments are strings still to place, or pattern numbers
+    segments, patterns = [text], []
+    while True:
+        free = [s for s in segments if isinstance(s, str)]
+        best = None
+        for seg in free:
+            for length in range(MIN_PATTERN, min(MAX_PATTERN, len(seg)) + 1):
+                seen = set()
+                for i in range(len(seg) - length + 1):
+                    sub = seg[i:i + length]
+                    if sub in seen:
+                        continue
+                    seen.add(sub)
+                    count = sum(s.count(sub) for s in free)
+                    if count < 2:
+                        continue
+                    # Pattern pointer, end and duration bytes, order entries,
+                    # and the same again for every leftover piece it leaves
+                    pieces = sum(len(list(filter(None, s.split(sub)))) - 1
+                                 for s in free)
+                    saving = (count - 1) * length - 6 - count - 7 * pieces
+                    if best is None or saving > best[0]:
+                        best = (saving, sub)
+        if best is None or best[0] <= 0:
+            break
+
+        sub, number = best[1], len(patterns)
+        patterns.append(sub)
+        split = []
+        for seg in segments:
+            if not isinstance(seg, str):
+                split.append(seg)
+                continue
+            parts = seg.split(sub)
+            for i, part in enumerate(parts):
+                if i:
+                    split.append(number)
+                if part:
+                    split.append(part)
+        segments = split
+
+    order = []
+    for seg in segments:
+        if isinstance(seg, str):
+            patterns.append(seg)
+            seg = len(patterns) - 1
+        if order and order[-1][0] == seg:
+            order[-1][1] += 1
+        else:
+            order.append([seg, 1])
+
+    # Repeats longer than the order list allows become separate entries
+    packed = []
+    for number, count in order:
+        while count:
+            packed.append((number, min(count, 0x7F)))
+            count -= min(count, 0x7F)
+    return [[tokens[c] for c in p] for p in patterns], packed
+
+
+def find_loop(seq):
+    """Best run seq[i:i+n] repeated k times, as (saving, i, n, k)"""
+    best = None
+    for n in range(1, len(seq) // 2 + 1):
+        for i in range(len(seq) - 2 * n + 1):
+            k = 1
+            while k < MAX_LOOP and seq[i:i + n] == seq[i + k * n:i + (k + 1) * n]:
+                k += 1
+            saving = (k - 1) * n - 2
+            if k > 1 and saving > 0 and (best is None or saving > best[0]):
+                best = (saving, i, n, k)
+    return best
+
+
+def encode_notes(seq, codes, dur):
+    out = []
+    for note, ms in seq:
+        if ms != dur:
+            out.append(SONG_DUR | codes[ms])
+            dur = ms
+        out.append(note)
+    return out, dur
+
+
+def encode_pattern(seq, codes, dur=None):
+    if not seq:
+        return [], dur
+    loop = find_loop(seq)
+    if loop is None:
+        return encode_notes(seq, codes, dur)
+
+    _, i, n, k = loop
+    out, dur = encode_pattern(seq[:i], codes, dur)
+    body = seq[i:i + n]
+    # Every pass has to start on the body's first duration
+    if body[-1][1] != body[0][1]:
+        dur = None
+    notes, dur = encode_notes(body, codes, dur)
+    out += [SONG_LOOP | k] + notes + [SONG_LOOP_END]
+    rest, dur = encode_pattern(seq[i + n * k:], codes, dur)
+    return out + rest, dur
+
+
+def decode(patterns, order, durations):
+    """Mirror of song_next(), to check the packing"""
+    notes = []
+    for number, count in order:
+        for _ in range(count):
+            code, pos, dur, loop = patterns[number], 0, None, None
+            while pos < len(code):
+                op = code[pos]
+                pos += 1
+                if op < 0x80:
+                    notes.append((op, dur))
+                elif op < 0xC0:
+                    dur = durations[op & 0x3F]
+                elif op & 0xF0 == SONG_LOOP:
+                    loop = [pos, (op & 0x0F) - 1]
+                elif op == SONG_LOOP_END and loop[1]:
+                    loop[1] -= 1
+                    pos = loop[0]
+    return notes
+
+
+def pack(tracks):
+    """Returns (patterns, [order per track], durations); the tracks share
+    one pattern pool, so a phrase two tracks play is stored once."""
+    tracks = quantize(tracks)
+    durations = sorted({ms for t in tracks for _, ms in t})
+    codes = {ms: i for i, ms in enumerate(durations)}
+    encoded, numbers, orders = [], {}, []
+    for notes in tracks:
+        patterns, order = find_patterns(notes)
+        local = []
+        for p in patterns:
+            code = tuple(encode_pattern(p, codes)[0] + [SONG_END])
+            if code not in numbers:
+                numbers[code] = len(encoded)
+                encoded.append(list(code))
+            local.append(numbers[code])
+        order = [(local[number], count) for number, count in order]
+        if decode(encoded, order, durations) != notes:
+            fail("packing check failed")
+        orders.append(order)
+    if len(encoded) > SONG_REPEAT:
+        fail("too many patterns")
+    return encoded, orders, durations
+
+
+# --- Output ---
+
+def c_array(decl, values, per_line=12):
+    lines = [f"{decl} = {{"]
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(values[i:i + per_line]) + ',')
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def period_ns(note):
+    return round(1e9 / (440 * 2 ** ((note - 69) / 12)))
+
+
+def write_tables(path, songs):
+    used = {n for _, tracks, noise in songs
+            for t, notes in enumerate(tracks) if t != noise
+            for n, _ in notes if n != REST}
+    lo, hi = (min(used), max(used)) if used else (1, 1)
+    # Drum keys are looked up like notes, so keep them within the table
+    for _, tracks, noise in songs:
+        if noise >= 0:
+            tracks[noise] = [(n and min(max(n, lo), hi), ms)
+                             for n, ms in tracks[noise]]
+    total = 0
+
+    out = [f"/* Generated by convert_songs.py, do not edit */",
+           '', '#include "song.h"', '',
+           f"const uint8_t song_note_lo = {lo};",
+           f"const uint8_t song_note_hi = {hi};", '',
+           c_array('const uint32_t song_period_ns[]',
+                   [str(period_ns(n)) for n in range(lo, hi + 1)], 8), '']
+
+    entries = []
+    for index, (title, tracks, noise) in enumerate(songs):
+        patterns, orders, durations = pack(tracks)
+        prefix = f"song{index}"
+        names = []
+        for number, code in enumerate(patterns):
+            names.append(f"{prefix}_p{number}")
+            out.append(c_array(f"static const uint8_t {names[-1]}[]",
+                               [f"0x{b:02x}" for b in code]))
+        order_names, size = [], 0
+        for track, order in enumerate(orders):
+            order_bytes = []
+            for number, count in order:
+                if count > 1:
+                    order_bytes.append(SONG_REPEAT | count)
+                order_bytes.append(number)
+            order_bytes.append(SONG_END)
+            order_names.append(f"{prefix}_order{track}")
+            out.append(c_array(f"static const uint8_t {order_names[-1]}[]",
+                               [f"0x{b:02x}" for b in order_bytes]))
+            size += len(order_bytes) + 4
+        out.append(c_array(f"static const uint8_t *const {prefix}_orders[]",
+                           order_names, 4))
+        out.append(c_array(f"static const uint8_t *const {prefix}_patterns[]",
+                           names, 4))
+        out.append(c_array(f"static const uint16_t {prefix}_durations[]",
+                           [str(d) for d in durations]))
+        out.append('')
+        title = title.replace('\\', '\\\\').replace('"', '\\"')
+        entries.append(f'{{"{title}", {prefix}_orders, {prefix}_patterns, '
+                       f'{prefix}_durations, {len(tracks)}, {noise}}}')
+
+        size += (sum(map(len, patterns)) + 4 * len(patterns) +
+                 2 * len(durations))
+        total += size
+        print(f"  {title}: {len(tracks)} track(s), "
+              f"{sum(map(len, tracks))} notes, {len(patterns)} patterns, "
+              f"{size} bytes")
+
+    out.append(c_array('const Song songs[]', entries, 1))
+    out.append(f"const int song_count = {len(songs)};")
+    with open(path, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+    print(f"  {len(songs)} songs, {total} bytes of song data")
+
+
+def load(path):
+    """Returns [(title, tracks, noise track or -1)]"""
+    if path.endswith('.mid'):
+        with open(path, 'rb') as f:
+            name, tracks, noise = parse_midi(f.read(), path)
+        stem = os.path.splitext(os.path.basename(path))[0]
+        return [(name or stem, tracks, noise)]
+
+    songs = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line and not line.startswith('#'):
+                title, notes = parse_rtttl(line, path)
+                songs.append((title, [notes], -1))
+    return songs
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(f"Usage: {sys.argv[0]} output.c [song.rtttl|song.mid]...")
+        exit(1)
+
+    songs = []
+    for path in sorted(sys.argv[2:], key=os.path.basename):
+        for title, tracks, noise in load(path):
+            if not any(tracks):
+                fail(f"{path}: '{title}' has no notes")
+            songs.append((title, tracks, noise))
+    write_tables(sys.argv[1], songs)
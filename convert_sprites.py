@@ -1,25 +1,170 @@
 import sys
-from PIL import Image
-import struct
+import re
 import os
+import struct
+import subprocess
+
+# LV_COLOR_FORMAT_I1: an 8-byte palette (two ARGB8888 entries, stored
+# b, g, r, a), then rows packed 8 pixels a byte, MSB first, each row padded
+# to a whole byte. Index 0 is black and 1 is white, as in PIL's mode '1'.
+PALETTE = [0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff]
+
+# Images that shrink by at least an eighth are stored run-length coded and
+# flagged LV_IMAGE_FLAGS_COMPRESSED: LVGL's 12-byte compressed header
+# (method, compressed size, unpacked size, little endian), then LVGL's RLE
+# with 1-byte blocks. A control byte with bit 7 set is followed by that many
+# literal bytes, otherwise the next byte repeats that many times.
+METHOD_RLE = 1
+RLE_MAX = 0x7f
+RLE_MIN_RUN = 3 # Shorter runs cost less as literals
+
+
+def stride_of(width):
+    return (width + 7) // 8
+
+
+def pack_i1(pixels, width, height):
+    """Packs one value per pixel (0 = black, anything else = white)."""
+    stride = stride_of(width)
+    packed = bytearray(stride * height)
+    for y in range(height):
+        for x in range(width):
+            if pixels[y * width + x]:
+                packed[y * stride + x // 8] |= 0x80 >> (x % 8)
+    return packed
+
+
+def unpack_i1(data, width, height):
+    stride = stride_of(width)
+    pixels = data[len(PALETTE):]
+    return [0xff if pixels[y * stride + x // 8] & (0x80 >> (x % 8)) else 0x00
+            for y in range(height) for x in range(width)]
+
+
+def rle_encode(data):
+    out = bytearray()
+    literals = bytearray()
+
+    def flush_literals():
+        for i in range(0, len(literals), RLE_MAX):
+            chunk = literals[i:i + RLE_MAX]
+            out.append(0x80 | len(chunk))
+            out.extend(chunk)
+        literals.clear()
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < RLE_MAX:
+            run += 1
+        if run >= RLE_MIN_RUN:
+            flush_literals()
+            out += bytes([run, data[i]])
+            i += run
+        else:
+            literals.append(data[i])
+            i += 1
+    flush_literals()
+    return bytes(out)
+
+
+def rle_decode(data, size):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        ctrl = data[i]
+        count = ctrl & RLE_MAX
+        if ctrl & 0x80:
+            out += data[i + 1:i + 1 + count]
+            i += 1 + count
+        else:
+            out += bytes([data[i + 1]]) * count
+            i += 2
+    if len(out) != size:
+        raise ValueError(f"RLE data unpacks to {len(out)} bytes, expected {size}")
+    return bytes(out)
+
+
+def compress(data):
+    """The image data as stored: RLE with its header, or as is."""
+    packed = rle_encode(data)
+    if len(packed) > len(data) * 7 // 8:
+        return data, False
+    header = struct.pack('<III', METHOD_RLE, len(packed), len(data))
+    return header + packed, True
+
+
+def load_png(input_path, width, height):
+    from PIL import Image  # Only needed for PNG input
 
-def convert_to_c_array(input_path, output_path, var_name, width, height):
     try:
         img = Image.open(input_path)
     except FileNotFoundError:
         print(f"Error: File {input_path} not found.")
-        return
-    
-    # print(f"Image mode: {img.mode}")
-    # if img.mode in ('1', 'L', 'P'):
-    #     print("Image is black and white or grayscale")
-    # else:
-    #     print("Image is color")
+        sys.exit(1)
 
     img = img.resize((width, height), Image.Resampling.LANCZOS)
-    # img = img.convert('RGB')
-    # grayscale_img = img.convert("L") 
     img = img.convert('1', dither=Image.Dither.FLOYDSTEINBERG) # B/W
+    return [0xff if p else 0x00 for p in img.getdata()]
+
+
+def load_c_array(input_path):
+    """Reads back an image this script wrote, L8 (old) or I1."""
+    with open(input_path) as f:
+        return parse_c_array(f.read(), input_path)
+
+
+def load_git_c_array(rev, path):
+    """The same, as the file was at a git revision."""
+    try:
+        src = subprocess.run(['git', 'show', f'{rev}:./{os.path.relpath(path)}'],
+                             capture_output=True, text=True, check=True).stdout
+    except subprocess.CalledProcessError as e:
+        print(f"Error: no {path} at {rev}: {e.stderr.strip()}")
+        return None
+    return parse_c_array(src, f"{rev}:{path}")
+
+
+def parse_c_array(src, input_path):
+    """(name, width, height, pixels), or None if src holds no image."""
+    match = re.search(r'uint8_t (\w+)_map\[\]', src)
+    if not match:
+        return None
+    var_name = match.group(1)
+    cf = re.search(r'\.header\.cf = (\w+)', src).group(1)
+    width = int(re.search(r'\.header\.w = (\d+)', src).group(1))
+    height = int(re.search(r'\.header\.h = (\d+)', src).group(1))
+    body = src[src.index('_map[] = {'):src.index('};')]
+    data = bytes(int(b, 16) for b in re.findall(r'0x([0-9a-fA-F]{2})', body))
+    if 'LV_IMAGE_FLAGS_COMPRESSED' in src:
+        method, packed, size = struct.unpack('<III', data[:12])
+        if method & 0xf != METHOD_RLE or packed != len(data) - 12:
+            print(f"Error: {input_path} has a bad compressed header")
+            sys.exit(1)
+        data = rle_decode(data[12:], size)
+
+    if cf == 'LV_COLOR_FORMAT_L8':
+        if len(data) != width * height:
+            print(f"Error: {input_path} has {len(data)} bytes, "
+                  f"expected {width * height}")
+            sys.exit(1)
+        pixels = list(data)
+    elif cf == 'LV_COLOR_FORMAT_I1':
+        if len(data) != len(PALETTE) + stride_of(width) * height:
+            print(f"Error: {input_path} has {len(data)} bytes, expected "
+                  f"{len(PALETTE) + stride_of(width) * height}")
+            sys.exit(1)
+        pixels = unpack_i1(data, width, height)
+    else:
+        print(f"Error: {input_path} is {cf}, cannot read it back")
+        sys.exit(1)
+    return var_name, width, height, pixels
+
+
+def write_c_array(output_path, var_name, width, height, pixels):
+    stride = stride_of(width)
+    raw = bytes(PALETTE) + pack_i1(pixels, width, height)
+    data, compressed = compress(raw)
 
     with open(output_path, 'w') as f:
         f.write('#include <lvgl.h>\n\n')
@@ -34,31 +179,104 @@ def convert_to_c_array(input_path, output_path, var_name, width, height):
 
         f.write(f'const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST {macro_name} uint8_t {var_name}_map[] = {{\n')
 
-        pixels = list(img.getdata())
-        for i, pixel in enumerate(pixels):
-            # r, g, b = pixel
-
-            f.write(f'0x{pixel:02x},')
-
-            if (i + 1) % width == 0:
-                f.write('\n')
+        if compressed:
+            # Header on its own line, then the RLE stream
+            lines = [data[:12]]
+            lines += [data[i:i + 32] for i in range(12, len(data), 32)]
+        else:
+            # Palette on its own line, then one line per row
+            lines = [data[:len(PALETTE)]]
+            lines += [data[i:i + stride] for i in range(len(PALETTE), len(data), stride)]
+        for line in lines:
+            f.write(''.join(f'0x{b:02x},' for b in line) + '\n')
 
         f.write('};\n\n')
 
         f.write(f'const lv_img_dsc_t {var_name} = {{\n')
         f.write(f'  .header.magic = LV_IMAGE_HEADER_MAGIC,\n')
-        f.write(f'  .header.cf = LV_COLOR_FORMAT_L8,\n')
+        f.write(f'  .header.cf = LV_COLOR_FORMAT_I1,\n')
+        if compressed:
+            f.write(f'  .header.flags = LV_IMAGE_FLAGS_COMPRESSED,\n')
         f.write(f'  .header.w = {width},\n')
         f.write(f'  .header.h = {height},\n')
-        f.write(f'  .data_size = {width * height},\n')
+        f.write(f'  .header.stride = {stride},\n')
+        f.write(f'  .data_size = {len(data)},\n')
         f.write(f'  .data = {var_name}_map,\n')
         f.write('};\n')
 
+
+def check(output_path, width, height, pixels, source="its source"):
+    """Reads the written file back: it must show exactly the source pixels."""
+    _, w, h, written = load_c_array(output_path)
+    if (w, h) != (width, height):
+        print(f"Error: {output_path} is {w}x{h}, {source} is {width}x{height}")
+        return False
+    expected = [0xff if p else 0x00 for p in pixels]
+    diff = sum(1 for a, b in zip(written, expected) if a != b)
+    if diff:
+        print(f"Error: {output_path} differs from {source} in {diff} pixels")
+        return False
+    size = len(PALETTE) + stride_of(width) * height
+    stored = stored_size(output_path)
+    print(f"{output_path}: {width}x{height}, {size} bytes, stored in {stored}, "
+          f"pixel-identical to {source}")
+    return True
+
+
+def stored_size(path):
+    with open(path) as f:
+        return int(re.search(r'\.data_size = (\d+)', f.read()).group(1))
+
+
+def usage():
+    print(f"Usage: {sys.argv[0]} input.png output.c c_image_name [width] [height]")
+    print(f"       {sys.argv[0]} --repack image.c [image.c ...]")
+    print(f"       {sys.argv[0]} --check <git-rev> image.c [image.c ...]")
+    sys.exit(1)
+
+
 if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        usage()
+
+    if sys.argv[1] == '--repack':
+        # Rewrites existing images (e.g. old one byte per pixel L8) as I1
+        for path in sys.argv[2:]:
+            image = load_c_array(path)
+            if not image:
+                print(f"{path}: no image array, skipped")
+                continue
+            name, w, h, pixels = image
+            if any(p not in (0x00, 0xff) for p in pixels):
+                print(f"Error: {path} is not black and white")
+                sys.exit(1)
+            write_c_array(path, name, w, h, pixels)
+            if not check(path, w, h, pixels, "the file it replaced"):
+                sys.exit(1)
+        sys.exit(0)
+
+    if sys.argv[1] == '--check':
+        # Against the same file at a revision, e.g. before a repack
+        if len(sys.argv) < 4:
+            usage()
+        rev = sys.argv[2]
+        failed = 0
+        for path in sys.argv[3:]:
+            if not load_c_array(path):
+                print(f"{path}: no image array, skipped")
+                continue
+            reference = load_git_c_array(rev, path)
+            if not reference:
+                print(f"Error: {path} has no image at {rev} to check against")
+                failed += 1
+                continue
+            _, w, h, pixels = reference
+            if not check(path, w, h, pixels, rev):
+                failed += 1
+        sys.exit(1 if failed else 0)
+
     if len(sys.argv) < 4:
-        name = sys.argv[1]
-        print(f"Usage: {sys.argv[0]} input.png output.c c_image_name [width] [height]")
-        exit(1)
+        usage()
 
     img_input = sys.argv[1]
     c_output = sys.argv[2]
@@ -67,4 +285,6 @@ if __name__ == '__main__':
     width = int(sys.argv[4]) if len(sys.argv) > 4 else 128
     height = int(sys.argv[5]) if len(sys.argv) > 5 else 128
 
-    convert_to_c_array(img_input, c_output, c_name, width, height)
+    pixels = load_png(img_input, width, height)
+    write_c_array(c_output, c_name, width, height, pixels)
+    check(c_output, width, height, pixels)